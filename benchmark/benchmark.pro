@@ -0,0 +1,43 @@
+# Standalone benchmark for the dict.cc import, not part of the application package.
+# Build it after the QuaZIP library, e.g. qmake && make in this directory, and run
+# ./wunderfitz-import-benchmark [--entries <count> [--infix] [--no-prefix] [--fts5]]
+
+TARGET = wunderfitz-import-benchmark
+TEMPLATE = app
+
+CONFIG += console
+CONFIG -= app_bundle
+QT += sql core
+QT -= gui
+
+CONFIG += link_pkgconfig
+PKGCONFIG += sqlite3
+
+LIBS += -lz -lquazip -L../quazip/quazip
+DEPENDPATH += . ../src ../quazip/quazip
+INCLUDEPATH += . ../src ../quazip/quazip
+QMAKE_LFLAGS += -Wl,-rpath,$$PWD/../quazip/quazip
+
+SOURCES += importbenchmark.cpp \
+    ../src/dictccimportworker.cpp \
+    ../src/dictccword.cpp \
+    ../src/dictccentry.cpp \
+    ../src/dictccimportqueue.cpp \
+    ../src/dictccreaderworker.cpp \
+    ../src/dictccparserworker.cpp \
+    ../src/dictionaryfuzzyindex.cpp \
+    ../src/dictionaryvocabulary.cpp \
+    ../src/dictionaryinfixindex.cpp \
+    ../src/dictionaryranking.cpp
+
+HEADERS += \
+    ../src/dictccimportworker.h \
+    ../src/dictccword.h \
+    ../src/dictccentry.h \
+    ../src/dictccimportqueue.h \
+    ../src/dictccreaderworker.h \
+    ../src/dictccparserworker.h \
+    ../src/dictionaryfuzzyindex.h \
+    ../src/dictionaryvocabulary.h \
+    ../src/dictionaryinfixindex.h \
+    ../src/dictionaryranking.h
@@ -0,0 +1,273 @@
+/*
+    Copyright (C) 2016-19 Sebastian J. Wolf
+
+    This file is part of Wunderfitz.
+
+    Wunderfitz is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    Wunderfitz is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Wunderfitz. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Headless benchmark for the dict.cc import. It generates synthetic dict.cc exports of different sizes,
+// imports them with DictCCImportWorker and reports throughput, wall time, peak memory, database size
+// and the latency of short prefix queries.
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QProcess>
+#include <QSettings>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <quazip.h>
+#include <quazipfile.h>
+#include <quazipnewinfo.h>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include "dictccimportworker.h"
+#include "dictionaryinfixindex.h"
+
+namespace {
+
+const char *syllables[] = { "haus", "tür", "bil", "for", "sik", "ring", "schmet", "ter", "ling", "stra", "ße",
+                            "øv", "el", "se", "fjell", "gå", "ende", "über", "setz", "ung", "café", "naïv",
+                            "wind", "mühle", "lyk", "ke", "spra", "che", "zeit", "ig" };
+const char *genders[] = { "{m}", "{f}", "{n}", "{pl}", "{adj}", "{verb}" };
+const char *optionals[] = { "[ugs.]", "[fig.]", "[südd.]", "[österr.]", "[veraltet]", "[Br.]" };
+const char *wordClasses[] = { "noun", "verb", "adj", "adv", "prep", "noun pl" };
+const char *subjects[] = { "[zool.]", "[bot.]", "[tech.]", "[med.]", "[geogr.]", "[hist.] [mil.]" };
+
+template <typename T, int N> int arraySize(T (&)[N]) { return N; }
+
+QString randomWord(int minimumSyllables, int maximumSyllables)
+{
+    QString word;
+    int syllableCount = minimumSyllables + qrand() % (maximumSyllables - minimumSyllables + 1);
+    for (int i = 0; i < syllableCount; i++) {
+        word.append(QString::fromUtf8(syllables[qrand() % arraySize(syllables)]));
+    }
+    return word;
+}
+
+QString randomSide()
+{
+    QString side = randomWord(1, 4);
+    if (qrand() % 3 == 0) {
+        side.append(" " + randomWord(1, 3));
+    }
+    if (qrand() % 2 == 0) {
+        side.append(" " + QString::fromUtf8(genders[qrand() % arraySize(genders)]));
+    }
+    if (qrand() % 5 == 0) {
+        side.append(" " + QString::fromUtf8(optionals[qrand() % arraySize(optionals)]));
+    }
+    return side;
+}
+
+bool createDictionaryArchive(const QString &archivePath, int entryCount)
+{
+    QuaZip zipArchive(archivePath);
+    if (!zipArchive.open(QuaZip::mdCreate)) {
+        return false;
+    }
+    QuaZipFile zipEntry(&zipArchive);
+    if (!zipEntry.open(QIODevice::WriteOnly, QuaZipNewInfo("benchmark.txt"))) {
+        return false;
+    }
+    qsrand(4711);
+    zipEntry.write("# DE-EN vocabulary database\tcompiled by dict.cc\n");
+    zipEntry.write("# Date and time\t2019-01-01 12:00\n");
+    zipEntry.write("# License\tsynthetic benchmark data\n");
+    for (int i = 0; i < entryCount; i++) {
+        QString line = randomSide() + "\t" + randomSide() + "\t" + QString::fromUtf8(wordClasses[qrand() % arraySize(wordClasses)]);
+        if (qrand() % 2 == 0) {
+            line.append("\t" + QString::fromUtf8(subjects[qrand() % arraySize(subjects)]));
+        }
+        line.append("\n");
+        zipEntry.write(line.toUtf8());
+    }
+    zipEntry.close();
+    zipArchive.close();
+    return zipEntry.getZipError() == 0 && zipArchive.getZipError() == 0;
+}
+
+qint64 getPeakResidentSetSize()
+{
+    QFile statusFile("/proc/self/status");
+    if (statusFile.open(QIODevice::ReadOnly)) {
+        QTextStream statusStream(&statusFile);
+        QString statusLine;
+        while (!(statusLine = statusStream.readLine()).isNull()) {
+            if (statusLine.startsWith("VmHWM:")) {
+                return statusLine.section(' ', 1, -1, QString::SectionSkipEmpty).section(' ', 0, 0).toLongLong();
+            }
+        }
+    }
+    return -1;
+}
+
+void ignoreDebugMessages(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    Q_UNUSED(context)
+    if (type != QtDebugMsg) {
+        QTextStream(stderr) << message << endl;
+    }
+}
+
+qint64 getInfixLatency(const QString &databaseFilePath)
+{
+    // Average time of an infix lookup in microseconds, the samples are syllables of the synthetic words
+    QStringList infixSamples;
+    infixSamples << QString::fromUtf8("ter") << QString::fromUtf8("ling") << QString::fromUtf8("setz")
+                 << QString::fromUtf8("mühle") << QString::fromUtf8("fjell") << QString::fromUtf8("ende");
+    qint64 elapsedNanoseconds = -1;
+    {
+        QSqlDatabase database = QSqlDatabase::addDatabase("QSQLITE", "benchmarkInfix");
+        database.setDatabaseName(databaseFilePath);
+        if (database.open() && DictionaryInfixIndex::isAvailable(database)) {
+            QElapsedTimer infixTimer;
+            infixTimer.start();
+            for (int i = 0; i < infixSamples.size(); i++) {
+                DictionaryInfixIndex::findWords(database, infixSamples.at(i));
+            }
+            elapsedNanoseconds = infixTimer.nsecsElapsed();
+        }
+        database.close();
+    }
+    QSqlDatabase::removeDatabase("benchmarkInfix");
+    return elapsedNanoseconds < 0 ? -1 : elapsedNanoseconds / infixSamples.size() / 1000;
+}
+
+QString getPrefixLatencies(const QString &databaseFilePath)
+{
+    // Average time of prefix queries with one to three characters in microseconds, like the search
+    // worker all matching rows are visited. The samples are beginnings of the synthetic words.
+    QList<QStringList> prefixSamples;
+    prefixSamples << (QStringList() << QString::fromUtf8("h") << QString::fromUtf8("s") << QString::fromUtf8("f") << QString::fromUtf8("ü"));
+    prefixSamples << (QStringList() << QString::fromUtf8("ha") << QString::fromUtf8("st") << QString::fromUtf8("fj") << QString::fromUtf8("üb"));
+    prefixSamples << (QStringList() << QString::fromUtf8("hau") << QString::fromUtf8("str") << QString::fromUtf8("fje") << QString::fromUtf8("übe"));
+    QStringList prefixLatencies;
+    {
+        QSqlDatabase database = QSqlDatabase::addDatabase("QSQLITE", "benchmarkPrefix");
+        database.setDatabaseName(databaseFilePath);
+        if (database.open()) {
+            bool fts5Storage = database.tables().contains("dictionary_search");
+            QSqlQuery prefixQuery(database);
+            prefixQuery.setForwardOnly(true);
+            if (fts5Storage) {
+                prefixQuery.prepare("select count(*) from dictionary_search where dictionary_search match (:queryString)");
+            } else {
+                prefixQuery.prepare("select count(*) from entries where entries match (:queryString)");
+            }
+            for (int i = 0; i < prefixSamples.size(); i++) {
+                const QStringList &samples = prefixSamples.at(i);
+                QElapsedTimer prefixTimer;
+                prefixTimer.start();
+                for (int j = 0; j < samples.size(); j++) {
+                    prefixQuery.bindValue(":queryString", fts5Storage ? "\"" + samples.at(j) + "\"*" : samples.at(j) + "*");
+                    prefixQuery.exec();
+                    prefixQuery.next();
+                }
+                prefixLatencies.append(QString::number(i + 1) + " chars " + QString::number(prefixTimer.nsecsElapsed() / samples.size() / 1000) + " us");
+            }
+            prefixQuery.finish();
+        }
+        database.close();
+    }
+    QSqlDatabase::removeDatabase("benchmarkPrefix");
+    return prefixLatencies.join(", ");
+}
+
+int runBenchmark(int entryCount, bool infixIndex, bool prefixIndex, bool fts5Storage)
+{
+    QTextStream output(stdout);
+    QTemporaryDir workingDirectory;
+    if (!workingDirectory.isValid()) {
+        output << "Unable to create a temporary directory" << endl;
+        return 1;
+    }
+    QString sourceDirectory = workingDirectory.path() + "/downloads";
+    QString databaseDirectory = workingDirectory.path() + "/databases";
+    QDir().mkpath(sourceDirectory);
+    QDir().mkpath(databaseDirectory);
+    if (!createDictionaryArchive(sourceDirectory + "/benchmark-" + QString::number(entryCount) + "-entries.zip", entryCount)) {
+        output << "Unable to create the synthetic dictionary" << endl;
+        return 1;
+    }
+    qint64 peakBeforeImport = getPeakResidentSetSize();
+
+    QSettings settings;
+    settings.remove(DictCCImportWorker::settingArchiveCatalog);
+    settings.setValue(DictCCImportWorker::settingInfixIndex, infixIndex);
+    settings.setValue(DictCCImportWorker::settingPrefixIndex, prefixIndex);
+    settings.setValue(DictCCImportWorker::settingFts5Storage, fts5Storage);
+    DictCCImportWorker importWorker;
+    importWorker.setSourceDirectory(sourceDirectory);
+    importWorker.setDatabaseDirectory(databaseDirectory);
+    QElapsedTimer importTimer;
+    importTimer.start();
+    importWorker.start();
+    importWorker.wait();
+    qint64 elapsedMilliseconds = qMax(Q_INT64_C(1), importTimer.elapsed());
+
+    QFileInfo databaseInfo(databaseDirectory + "/DE-EN.db");
+    output << "Entries:         " << entryCount << endl;
+    output << "Infix index:     " << (infixIndex ? "yes" : "no") << endl;
+    output << "Prefix index:    " << (prefixIndex ? "yes" : "no") << endl;
+    output << "FTS5 storage:    " << (fts5Storage ? "yes" : "no") << endl;
+    output << "Wall time:       " << elapsedMilliseconds << " ms" << endl;
+    output << "Throughput:      " << (entryCount * Q_INT64_C(1000) / elapsedMilliseconds) << " lines/s" << endl;
+    output << "Peak RSS:        " << getPeakResidentSetSize() << " kB (" << peakBeforeImport << " kB before import)" << endl;
+    output << "Database size:   " << (databaseInfo.exists() ? databaseInfo.size() / 1024 : -1) << " kB" << endl;
+    output << "Prefix queries:  " << getPrefixLatencies(databaseInfo.absoluteFilePath()) << endl;
+    if (infixIndex) {
+        output << "Infix lookup:    " << getInfixLatency(databaseInfo.absoluteFilePath()) << " us" << endl;
+    }
+    output << endl;
+    return databaseInfo.exists() ? 0 : 1;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication application(argc, argv);
+    QCoreApplication::setOrganizationName("harbour-wunderfitz-benchmark");
+    QCoreApplication::setApplicationName("harbour-wunderfitz-benchmark");
+    qInstallMessageHandler(ignoreDebugMessages);
+
+    QStringList arguments = application.arguments();
+    int entriesIndex = arguments.indexOf("--entries");
+    if (entriesIndex != -1 && entriesIndex + 1 < arguments.size()) {
+        return runBenchmark(arguments.at(entriesIndex + 1).toInt(), arguments.contains("--infix"), !arguments.contains("--no-prefix"), arguments.contains("--fts5"));
+    }
+
+    // Each size runs in its own process, so the peak memory of one run doesn't hide the next one.
+    // Every size is imported without prefix indexes, with them, with the optional infix index in addition
+    // and with the optional FTS5 storage.
+    QList<int> entryCounts;
+    entryCounts << 10000 << 100000 << 1000000;
+    int result = 0;
+    QListIterator<int> entryCountsIterator(entryCounts);
+    while (entryCountsIterator.hasNext()) {
+        QStringList benchmarkArguments;
+        benchmarkArguments << "--entries" << QString::number(entryCountsIterator.next());
+        result |= QProcess::execute(QCoreApplication::applicationFilePath(), QStringList(benchmarkArguments) << "--no-prefix");
+        result |= QProcess::execute(QCoreApplication::applicationFilePath(), benchmarkArguments);
+        result |= QProcess::execute(QCoreApplication::applicationFilePath(), QStringList(benchmarkArguments) << "--fts5");
+        result |= QProcess::execute(QCoreApplication::applicationFilePath(), benchmarkArguments << "--infix");
+    }
+    return result;
+}
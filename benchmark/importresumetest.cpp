@@ -0,0 +1,210 @@
+/*
+    Copyright (C) 2016-19 Sebastian J. Wolf
+
+    This file is part of Wunderfitz.
+
+    Wunderfitz is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    Wunderfitz is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Wunderfitz. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// QtTest target for resuming an interrupted dict.cc import. An import in a child process is killed
+// between two checkpoints, the next import has to continue after the last checkpoint and has to
+// produce the complete dictionary without leaving the shadow database or its journal behind.
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QProcess>
+#include <QSettings>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QtTest>
+#include <quazip.h>
+#include <quazipfile.h>
+#include <quazipnewinfo.h>
+#include "dictccimportworker.h"
+
+namespace {
+
+const int entryCount = 500000;
+
+bool createDictionaryArchive(const QString &archivePath)
+{
+    QuaZip zipArchive(archivePath);
+    if (!zipArchive.open(QuaZip::mdCreate)) {
+        return false;
+    }
+    QuaZipFile zipEntry(&zipArchive);
+    if (!zipEntry.open(QIODevice::WriteOnly, QuaZipNewInfo("resume.txt"))) {
+        return false;
+    }
+    zipEntry.write("# DE-EN vocabulary database\tcompiled by dict.cc\n");
+    zipEntry.write("# Date and time\t2019-01-01 12:00\n");
+    for (int i = 1; i <= entryCount; i++) {
+        zipEntry.write(QString("Wort" + QString::number(i) + " {n}\tword" + QString::number(i) + "\tnoun\n").toUtf8());
+    }
+    zipEntry.close();
+    zipArchive.close();
+    return zipEntry.getZipError() == 0 && zipArchive.getZipError() == 0;
+}
+
+void ignoreDebugMessages(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    Q_UNUSED(context)
+    if (type != QtDebugMsg) {
+        QTextStream(stderr) << message << endl;
+    }
+}
+
+}
+
+// Receives the status of the import worker in its own thread, the connections are direct ones
+class ImportStatusRecorder : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ImportStatusRecorder(bool printStatus) : printStatus(printStatus) {}
+    QStringList getStatusTexts() const { return statusTexts; }
+
+public slots:
+    void handleStatusChanged(const QString &statusText)
+    {
+        if (printStatus) {
+            QTextStream output(stdout);
+            output << QString(statusText).replace('\n', ' ') << endl;
+        } else {
+            statusTexts.append(statusText);
+        }
+    }
+
+private:
+    bool printStatus;
+    QStringList statusTexts;
+};
+
+class ImportResumeTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void resumeInterruptedImport();
+
+private:
+    QTemporaryDir workingDirectory;
+    QString sourceDirectory;
+    QString databaseDirectory;
+};
+
+void ImportResumeTest::initTestCase()
+{
+    QVERIFY(workingDirectory.isValid());
+    sourceDirectory = workingDirectory.path() + "/downloads";
+    databaseDirectory = workingDirectory.path() + "/databases";
+    QVERIFY(QDir().mkpath(sourceDirectory));
+    QVERIFY(QDir().mkpath(databaseDirectory));
+    QVERIFY(createDictionaryArchive(sourceDirectory + "/resume.zip"));
+
+    QSettings settings;
+    settings.remove(DictCCImportWorker::settingArchiveCatalog);
+    settings.setValue(DictCCImportWorker::settingInfixIndex, false);
+    settings.setValue(DictCCImportWorker::settingPrefixIndex, true);
+    settings.setValue(DictCCImportWorker::settingFts5Storage, false);
+    settings.sync();
+}
+
+void ImportResumeTest::resumeInterruptedImport()
+{
+    // Killed after the first checkpoint, in the middle of a later batch
+    QProcess importProcess;
+    importProcess.start(QCoreApplication::applicationFilePath(), QStringList() << "--import" << sourceDirectory << databaseDirectory);
+    QVERIFY(importProcess.waitForStarted());
+    int importedEntries = 0;
+    while (importedEntries <= (DictCCImportWorker::checkpointInterval + 10) * 1000) {
+        if (!importProcess.canReadLine() && !importProcess.waitForReadyRead(60000)) {
+            break;
+        }
+        while (importProcess.canReadLine()) {
+            QString statusLine = QString::fromUtf8(importProcess.readLine());
+            if (statusLine.contains(" entries imported.")) {
+                importedEntries = statusLine.section(' ', 0, 0).toInt();
+            }
+        }
+    }
+    importProcess.kill();
+    importProcess.waitForFinished();
+    QString shadowFilePath = databaseDirectory + "/DE-EN.db.tmp";
+    QVERIFY2(QFile::exists(shadowFilePath), "The import wasn't interrupted");
+    QVERIFY(!QFile::exists(databaseDirectory + "/DE-EN.db"));
+
+    ImportStatusRecorder statusRecorder(false);
+    DictCCImportWorker importWorker;
+    connect(&importWorker, SIGNAL(statusChanged(QString)), &statusRecorder, SLOT(handleStatusChanged(QString)), Qt::DirectConnection);
+    importWorker.setSourceDirectory(sourceDirectory);
+    importWorker.setDatabaseDirectory(databaseDirectory);
+    importWorker.start();
+    QVERIFY(importWorker.wait());
+
+    QStringList resumeStatusTexts = statusRecorder.getStatusTexts().filter("Resuming import after entry ");
+    QCOMPARE(resumeStatusTexts.size(), 1);
+    QVERIFY(resumeStatusTexts.first().section(' ', -1).toInt() >= DictCCImportWorker::checkpointInterval * 1000);
+    QVERIFY(!QFile::exists(shadowFilePath));
+    QVERIFY(!QFile::exists(shadowFilePath + "-journal"));
+
+    int storedEntries = 0;
+    {
+        QSqlDatabase database = QSqlDatabase::addDatabase("QSQLITE", "resumeTest");
+        database.setDatabaseName(databaseDirectory + "/DE-EN.db");
+        QVERIFY(database.open());
+        QSqlQuery countQuery(database);
+        QVERIFY(countQuery.exec("select count(*), count(distinct id) from entries"));
+        QVERIFY(countQuery.next());
+        storedEntries = countQuery.value(0).toInt();
+        QCOMPARE(countQuery.value(1).toInt(), storedEntries);
+        countQuery.finish();
+        database.close();
+    }
+    QSqlDatabase::removeDatabase("resumeTest");
+    QCOMPARE(storedEntries, entryCount);
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication application(argc, argv);
+    QCoreApplication::setOrganizationName("harbour-wunderfitz-benchmark");
+    QCoreApplication::setApplicationName("harbour-wunderfitz-benchmark");
+    qInstallMessageHandler(ignoreDebugMessages);
+
+    // The child process of the test imports and reports its progress on stdout until it's killed
+    QStringList arguments = application.arguments();
+    int importIndex = arguments.indexOf("--import");
+    if (importIndex != -1 && importIndex + 2 < arguments.size()) {
+        ImportStatusRecorder statusPrinter(true);
+        DictCCImportWorker importWorker;
+        QObject::connect(&importWorker, SIGNAL(statusChanged(QString)), &statusPrinter, SLOT(handleStatusChanged(QString)), Qt::DirectConnection);
+        importWorker.setSourceDirectory(arguments.at(importIndex + 1));
+        importWorker.setDatabaseDirectory(arguments.at(importIndex + 2));
+        importWorker.start();
+        importWorker.wait();
+        return 0;
+    }
+
+    ImportResumeTest importResumeTest;
+    return QTest::qExec(&importResumeTest, argc, argv);
+}
+
+#include "importresumetest.moc"
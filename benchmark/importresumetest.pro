@@ -0,0 +1,43 @@
+# QtTest target for resuming an interrupted dict.cc import, not part of the application package.
+# Build it after the QuaZIP library with qmake importresumetest.pro && make in this directory,
+# and run ./wunderfitz-import-resume-test directly or with make check
+
+TARGET = wunderfitz-import-resume-test
+TEMPLATE = app
+
+CONFIG += console testcase
+CONFIG -= app_bundle
+QT += sql core testlib
+QT -= gui
+
+CONFIG += link_pkgconfig
+PKGCONFIG += sqlite3
+
+LIBS += -lz -lquazip -L../quazip/quazip
+DEPENDPATH += . ../src ../quazip/quazip
+INCLUDEPATH += . ../src ../quazip/quazip
+QMAKE_LFLAGS += -Wl,-rpath,$$PWD/../quazip/quazip
+
+SOURCES += importresumetest.cpp \
+    ../src/dictccimportworker.cpp \
+    ../src/dictccword.cpp \
+    ../src/dictccentry.cpp \
+    ../src/dictccimportqueue.cpp \
+    ../src/dictccreaderworker.cpp \
+    ../src/dictccparserworker.cpp \
+    ../src/dictionaryfuzzyindex.cpp \
+    ../src/dictionaryvocabulary.cpp \
+    ../src/dictionaryinfixindex.cpp \
+    ../src/dictionaryranking.cpp
+
+HEADERS += \
+    ../src/dictccimportworker.h \
+    ../src/dictccword.h \
+    ../src/dictccentry.h \
+    ../src/dictccimportqueue.h \
+    ../src/dictccreaderworker.h \
+    ../src/dictccparserworker.h \
+    ../src/dictionaryfuzzyindex.h \
+    ../src/dictionaryvocabulary.h \
+    ../src/dictionaryinfixindex.h \
+    ../src/dictionaryranking.h
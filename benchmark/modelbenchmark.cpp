@@ -0,0 +1,156 @@
+/*
+    Copyright (C) 2016-19 Sebastian J. Wolf
+
+    This file is part of Wunderfitz.
+
+    Wunderfitz is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    Wunderfitz is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Wunderfitz. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Headless benchmark for HeinzelnisseModel::data(). It searches a synthetic dictionary and reads the
+// fields which the result delegates display, as the ListView does while scrolling.
+// The benchmark works with role-based models and with models returning a map for Qt::DisplayRole,
+// so it can be run on older revisions for comparison.
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QHash>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QStandardPaths>
+#include <QStringList>
+#include <QTextStream>
+#include <QVariantMap>
+#include "heinzelnissemodel.h"
+
+namespace {
+
+const char *benchmarkDictionaryId = "benchmark";
+const int benchmarkEntries = 20000;
+const int benchmarkIterations = 2000;
+
+bool createDictionary(const QString &databaseFilePath)
+{
+    bool success = false;
+    {
+        QSqlDatabase database = QSqlDatabase::addDatabase("QSQLITE", "benchmark");
+        database.setDatabaseName(databaseFilePath);
+        if (database.open()) {
+            QSqlQuery query(database);
+            query.exec("create virtual table entries using fts4(id, left_word, left_gender, left_other, right_word, right_gender, right_other, category, tokenize=unicode61 \"remove_diacritics=0\")");
+            database.transaction();
+            query.prepare("insert into entries values (?, ?, ?, ?, ?, ?, ?, ?)");
+            for (int i = 1; i <= benchmarkEntries; i++) {
+                query.addBindValue(i);
+                query.addBindValue("Haus" + QString::number(i) + " am See");
+                query.addBindValue("{n}");
+                query.addBindValue("[ugs.]");
+                query.addBindValue("house " + QString::number(i) + " by the lake");
+                query.addBindValue("");
+                query.addBindValue("[Br.]");
+                query.addBindValue("noun");
+                query.exec();
+            }
+            success = database.commit();
+            database.close();
+        }
+    }
+    QSqlDatabase::removeDatabase("benchmark");
+    return success;
+}
+
+void ignoreDebugMessages(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    Q_UNUSED(context)
+    if (type != QtDebugMsg) {
+        QTextStream(stderr) << message << endl;
+    }
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication application(argc, argv);
+    QCoreApplication::setOrganizationName("harbour-wunderfitz-benchmark");
+    QCoreApplication::setApplicationName("harbour-wunderfitz-benchmark");
+    qInstallMessageHandler(ignoreDebugMessages);
+    QStandardPaths::setTestModeEnabled(true);
+    QTextStream output(stdout);
+
+    QString databaseDirectory = QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) + "/harbour-wunderfitz";
+    QString databaseFilePath = databaseDirectory + "/" + benchmarkDictionaryId + ".db";
+    QDir().mkpath(databaseDirectory);
+    QFile::remove(databaseFilePath);
+    if (!createDictionary(databaseFilePath)) {
+        output << "Unable to create the synthetic dictionary" << endl;
+        return 1;
+    }
+
+    HeinzelnisseModel heinzelnisseModel;
+    heinzelnisseModel.setDictionaryId(benchmarkDictionaryId);
+    QEventLoop searchLoop;
+    QObject::connect(&heinzelnisseModel, SIGNAL(searchStatusChanged()), &searchLoop, SLOT(quit()));
+    heinzelnisseModel.search("haus");
+    searchLoop.exec();
+    int rowCount = heinzelnisseModel.rowCount(QModelIndex());
+    if (rowCount == 0) {
+        output << "The search didn't return any results" << endl;
+        QFile::remove(databaseFilePath);
+        return 1;
+    }
+
+    // The fields which are shown by the result delegate in TitlePage.qml
+    QStringList delegateFields;
+    delegateFields << "wordLeft" << "genderLeft" << "otherLeft" << "wordRight" << "genderRight" << "otherRight";
+    QHash<int, QByteArray> roleNames = heinzelnisseModel.roleNames();
+    QList<int> delegateRoles;
+    for (int i = 0; i < delegateFields.size(); i++) {
+        int role = roleNames.key(delegateFields.at(i).toUtf8(), -1);
+        if (role != -1) {
+            delegateRoles.append(role);
+        }
+    }
+    bool mapBasedModel = delegateRoles.isEmpty();
+
+    QElapsedTimer dataTimer;
+    dataTimer.start();
+    int readCharacters = 0;
+    for (int iteration = 0; iteration < benchmarkIterations; iteration++) {
+        for (int row = 0; row < rowCount; row++) {
+            QModelIndex rowIndex = heinzelnisseModel.index(row);
+            if (mapBasedModel) {
+                QVariantMap resultMap = heinzelnisseModel.data(rowIndex, Qt::DisplayRole).toMap();
+                for (int i = 0; i < delegateFields.size(); i++) {
+                    readCharacters += resultMap.value(delegateFields.at(i)).toString().length();
+                }
+            } else {
+                for (int i = 0; i < delegateRoles.size(); i++) {
+                    readCharacters += heinzelnisseModel.data(rowIndex, delegateRoles.at(i)).toString().length();
+                }
+            }
+        }
+    }
+    qint64 elapsedNanoseconds = dataTimer.nsecsElapsed();
+
+    output << "Model type:      " << (mapBasedModel ? "map for Qt::DisplayRole" : "roles") << endl;
+    output << "Rows:            " << rowCount << endl;
+    output << "Rows read:       " << (qint64(rowCount) * benchmarkIterations) << " (" << readCharacters << " characters)" << endl;
+    output << "data() per row:  " << (elapsedNanoseconds / (qint64(rowCount) * benchmarkIterations)) << " ns" << endl;
+
+    QFile::remove(databaseFilePath);
+    return 0;
+}
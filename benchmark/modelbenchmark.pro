@@ -0,0 +1,61 @@
+# Standalone benchmark for HeinzelnisseModel::data(), not part of the application package.
+# Build it after the QuaZIP library, e.g. qmake modelbenchmark.pro && make in this directory, and run
+# ./wunderfitz-model-benchmark
+
+TARGET = wunderfitz-model-benchmark
+TEMPLATE = app
+
+CONFIG += console
+CONFIG -= app_bundle
+QT += sql core
+QT -= gui
+
+CONFIG += link_pkgconfig
+PKGCONFIG += sqlite3
+
+LIBS += -lz -lquazip -L../quazip/quazip
+DEPENDPATH += . ../src ../quazip/quazip
+INCLUDEPATH += . ../src ../quazip/quazip
+QMAKE_LFLAGS += -Wl,-rpath,$$PWD/../quazip/quazip
+
+SOURCES += modelbenchmark.cpp \
+    ../src/databasemanager.cpp \
+    ../src/heinzelnisseelement.cpp \
+    ../src/heinzelnissemodel.cpp \
+    ../src/dictccimportermodel.cpp \
+    ../src/dictccimportworker.cpp \
+    ../src/dictionarymodel.cpp \
+    ../src/dictionarymetadata.cpp \
+    ../src/dictccword.cpp \
+    ../src/dictionaryconnectionpool.cpp \
+    ../src/dictionaryfuzzyindex.cpp \
+    ../src/dictionaryvocabulary.cpp \
+    ../src/dictionaryinfixindex.cpp \
+    ../src/dictionarysearchcache.cpp \
+    ../src/dictionarysearchworker.cpp \
+    ../src/dictccentry.cpp \
+    ../src/dictccimportqueue.cpp \
+    ../src/dictccreaderworker.cpp \
+    ../src/dictccparserworker.cpp \
+    ../src/dictionaryranking.cpp
+
+HEADERS += \
+    ../src/heinzelnisseelement.h \
+    ../src/databasemanager.h \
+    ../src/heinzelnissemodel.h \
+    ../src/dictccimportermodel.h \
+    ../src/dictccimportworker.h \
+    ../src/dictionarymodel.h \
+    ../src/dictionarymetadata.h \
+    ../src/dictccword.h \
+    ../src/dictionaryconnectionpool.h \
+    ../src/dictionaryfuzzyindex.h \
+    ../src/dictionaryvocabulary.h \
+    ../src/dictionaryinfixindex.h \
+    ../src/dictionarysearchcache.h \
+    ../src/dictionarysearchworker.h \
+    ../src/dictccentry.h \
+    ../src/dictccimportqueue.h \
+    ../src/dictccreaderworker.h \
+    ../src/dictccparserworker.h \
+    ../src/dictionaryranking.h
@@ -0,0 +1,162 @@
+/*
+    Copyright (C) 2016-19 Sebastian J. Wolf
+
+    This file is part of Wunderfitz.
+
+    Wunderfitz is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    Wunderfitz is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Wunderfitz. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// QtTest target for the dict.cc word parser. It checks DictCCParserWorker::getDictCCWord() against the
+// former implementation based on regular expressions and compares the speed of both section lookups.
+
+#include <QRegExp>
+#include <QStringList>
+#include <QtTest>
+#include "dictccparserworker.h"
+#include "dictccword.h"
+
+namespace {
+
+// getDictCCWord() as it was implemented before, with the greedy expressions "\{.+\}" and "\[.+\]"
+DictCCWord getDictCCWordWithRegExp(QString rawWord)
+{
+    DictCCWord dictCCWord;
+    QString realWord = rawWord;
+    QRegExp genderMatcher("(\\{.+\\})");
+    if (genderMatcher.indexIn(realWord) != -1) {
+        QString genderString = genderMatcher.cap(1);
+        genderString = genderString.replace("{", "(");
+        genderString = genderString.replace("}", ")");
+        dictCCWord.setGender(genderString);
+        realWord = realWord.remove(genderMatcher);
+    }
+    QRegExp optionalMatcher("(\\[.+\\])");
+    if (optionalMatcher.indexIn(realWord) != -1) {
+        dictCCWord.setOptional(optionalMatcher.cap(1));
+        realWord = realWord.remove(optionalMatcher);
+    }
+    dictCCWord.setWord(realWord.trimmed());
+    return dictCCWord;
+}
+
+QStringList getBenchmarkWords()
+{
+    QStringList benchmarkWords;
+    benchmarkWords << QString::fromUtf8("Haus {n}") << QString::fromUtf8("Häuser {pl}") << QString::fromUtf8("to go")
+                   << QString::fromUtf8("Schmetterling {m} [zool.]") << QString::fromUtf8("[ugs.] Kiste {f}")
+                   << QString::fromUtf8("øvelse {m/f}") << QString::fromUtf8("fast [fig.] [ugs.]") << QString::fromUtf8("Straße {f}");
+    return benchmarkWords;
+}
+
+}
+
+class ParserBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void getDictCCWord_data();
+    void getDictCCWord();
+    void findSection_data();
+    void findSection();
+    void benchmarkRegExp();
+    void benchmarkFindSection();
+};
+
+void ParserBenchmark::getDictCCWord_data()
+{
+    QTest::addColumn<QString>("rawWord");
+
+    QTest::newRow("plain") << QString::fromUtf8("Haus");
+    QTest::newRow("empty") << QString();
+    QTest::newRow("whitespace") << QString::fromUtf8("   ");
+    QTest::newRow("gender") << QString::fromUtf8("Haus {n}");
+    QTest::newRow("optional") << QString::fromUtf8("[ugs.] Kiste");
+    QTest::newRow("gender and optional") << QString::fromUtf8("Wort {m} [ugs.] [fig.]");
+    QTest::newRow("optional before gender") << QString::fromUtf8("Wort [fig.] {f}");
+    QTest::newRow("two genders") << QString::fromUtf8("a {b} c {d}");
+    QTest::newRow("nested braces") << QString::fromUtf8("a {b {c} d}");
+    QTest::newRow("nested brackets") << QString::fromUtf8("[[x]]");
+    QTest::newRow("brackets in braces") << QString::fromUtf8("{[x]}");
+    QTest::newRow("braces in brackets") << QString::fromUtf8("[{x}]");
+    QTest::newRow("empty braces") << QString::fromUtf8("Wort {}");
+    QTest::newRow("empty brackets") << QString::fromUtf8("Wort []");
+    QTest::newRow("space in braces") << QString::fromUtf8("{ }");
+    QTest::newRow("empty braces and closing brace") << QString::fromUtf8("{}}");
+    QTest::newRow("empty braces before closing brace") << QString::fromUtf8("a{}b}");
+    QTest::newRow("additional closing brace") << QString::fromUtf8("{x}}");
+    QTest::newRow("unbalanced opening brace") << QString::fromUtf8("a {b");
+    QTest::newRow("unbalanced closing brace") << QString::fromUtf8("a b}");
+    QTest::newRow("unbalanced opening bracket") << QString::fromUtf8("a [b");
+    QTest::newRow("reversed braces") << QString::fromUtf8("a }b{ c");
+    QTest::newRow("reversed brackets") << QString::fromUtf8("]x[");
+    QTest::newRow("line break in braces") << QString::fromUtf8("a {\n} b");
+    QTest::newRow("non-latin") << QString::fromUtf8("øvelse {m/f} [sport]");
+}
+
+void ParserBenchmark::getDictCCWord()
+{
+    QFETCH(QString, rawWord);
+
+    DictCCWord expectedWord = getDictCCWordWithRegExp(rawWord);
+    DictCCWord parsedWord = DictCCParserWorker::getDictCCWord(rawWord);
+    QCOMPARE(parsedWord.getWord(), expectedWord.getWord());
+    QCOMPARE(parsedWord.getGender(), expectedWord.getGender());
+    QCOMPARE(parsedWord.getOptional(), expectedWord.getOptional());
+}
+
+void ParserBenchmark::findSection_data()
+{
+    getDictCCWord_data();
+}
+
+void ParserBenchmark::findSection()
+{
+    QFETCH(QString, rawWord);
+
+    QRegExp sectionMatcher("(\\{.+\\})");
+    int sectionStart;
+    int sectionLength;
+    bool sectionFound = DictCCParserWorker::findSection(rawWord, QLatin1Char('{'), QLatin1Char('}'), sectionStart, sectionLength);
+    int expectedStart = sectionMatcher.indexIn(rawWord);
+    QCOMPARE(sectionFound, expectedStart != -1);
+    if (sectionFound) {
+        QCOMPARE(sectionStart, expectedStart);
+        QCOMPARE(sectionLength, sectionMatcher.matchedLength());
+    }
+}
+
+void ParserBenchmark::benchmarkRegExp()
+{
+    QStringList benchmarkWords = getBenchmarkWords();
+    QBENCHMARK {
+        for (int i = 0; i < benchmarkWords.size(); i++) {
+            getDictCCWordWithRegExp(benchmarkWords.at(i));
+        }
+    }
+}
+
+void ParserBenchmark::benchmarkFindSection()
+{
+    QStringList benchmarkWords = getBenchmarkWords();
+    QBENCHMARK {
+        for (int i = 0; i < benchmarkWords.size(); i++) {
+            DictCCParserWorker::getDictCCWord(benchmarkWords.at(i));
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(ParserBenchmark)
+
+#include "parserbenchmark.moc"
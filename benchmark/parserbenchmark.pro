@@ -0,0 +1,26 @@
+# QtTest target for the dict.cc word parser, not part of the application package.
+# Build it with qmake parserbenchmark.pro && make in this directory, and run
+# ./wunderfitz-parser-benchmark - add e.g. -iterations 100000 for stable benchmark numbers
+
+TARGET = wunderfitz-parser-benchmark
+TEMPLATE = app
+
+CONFIG += console testcase
+CONFIG -= app_bundle
+QT += core testlib
+QT -= gui
+
+DEPENDPATH += . ../src
+INCLUDEPATH += . ../src
+
+SOURCES += parserbenchmark.cpp \
+    ../src/dictccparserworker.cpp \
+    ../src/dictccimportqueue.cpp \
+    ../src/dictccentry.cpp \
+    ../src/dictccword.cpp
+
+HEADERS += \
+    ../src/dictccparserworker.h \
+    ../src/dictccimportqueue.h \
+    ../src/dictccentry.h \
+    ../src/dictccword.h
@@ -62,7 +62,7 @@ CoverBackground {
                 maximumLineCount: 1
                 color: Theme.primaryColor
                 font.pixelSize: Theme.fontSizeExtraSmall
-                text: display.wordLeft
+                text: model.wordLeft
                 truncationMode: TruncationMode.Fade
                 anchors {
                     left: parent.left
@@ -74,7 +74,7 @@ CoverBackground {
                 maximumLineCount: 1
                 color: Theme.highlightColor
                 font.pixelSize: Theme.fontSizeExtraSmall
-                text: display.wordRight
+                text: model.wordRight
                 truncationMode: TruncationMode.Fade
                 anchors {
                     top: resultLabelNorwegian.bottom
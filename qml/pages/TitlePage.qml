@@ -319,19 +319,19 @@ Page {
                                         MenuItem {
                                             text: qsTr("Copy to clipboard")
                                             onClicked: {
-                                                Clipboard.text = display.clipboardText
+                                                Clipboard.text = model.clipboardText
                                             }
                                         }
                                         MenuItem {
-                                            text: qsTr("Search for '%1'").arg(display.wordLeft)
+                                            text: qsTr("Search for '%1'").arg(model.wordLeft)
                                             onClicked: {
-                                                searchField.text = display.wordLeft
+                                                searchField.text = model.wordLeft
                                             }
                                         }
                                         MenuItem {
-                                            text: qsTr("Search for '%1'").arg(display.wordRight)
+                                            text: qsTr("Search for '%1'").arg(model.wordRight)
                                             onClicked: {
-                                                searchField.text = display.wordRight
+                                                searchField.text = model.wordRight
                                             }
                                         }
                                     }
@@ -351,7 +351,7 @@ Page {
                                                 x: Theme.horizontalPageMargin
                                                 wrapMode: Text.Wrap
                                                 truncationMode: TruncationMode.Fade
-                                                text: display.wordLeft + " " + display.genderLeft
+                                                text: model.wordLeft + " " + model.genderLeft
                                             }
 
                                             Label {
@@ -361,7 +361,7 @@ Page {
                                                 x: Theme.horizontalPageMargin
                                                 wrapMode: Text.Wrap
                                                 truncationMode: TruncationMode.Fade
-                                                text: display.otherLeft
+                                                text: model.otherLeft
                                             }
                                         }
                                         Column {
@@ -374,7 +374,7 @@ Page {
                                                 x: Theme.horizontalPageMargin
                                                 wrapMode: Text.Wrap
                                                 truncationMode: TruncationMode.Fade
-                                                text: display.wordRight + " " + display.genderRight
+                                                text: model.wordRight + " " + model.genderRight
                                             }
                                             Label {
                                                 width: parent.width
@@ -383,7 +383,7 @@ Page {
                                                 x: Theme.horizontalPageMargin
                                                 wrapMode: Text.Wrap
                                                 truncationMode: TruncationMode.Fade
-                                                text: display.otherRight
+                                                text: model.otherRight
                                             }
                                         }
                                     }
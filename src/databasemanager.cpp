@@ -20,79 +20,157 @@
 #include <QDebug>
 #include <QList>
 #include <QListIterator>
+#include <QMetaType>
 #include <QString>
 #include <QSqlError>
 #include <QtAlgorithms>
 #include "heinzelnisseelement.h"
 #include "databasemanager.h"
 #include "dictionarymodel.h"
+#include "dictionaryconnectionpool.h"
 #include "dictionarysearchworker.h"
 
-DatabaseManager::DatabaseManager(QObject *parent) : QObject(parent) {
+const QString DatabaseManager::settingCacheSize = QString("search/cacheSize");
 
-    resultList = new QList<HeinzelnisseElement*>();
-    searchWorker = new DictionarySearchWorker(resultList);
-    connect(searchWorker, SIGNAL(searchCompleted(QString)), this, SLOT(handleSearchCompleted(QString)));
+DatabaseManager::DatabaseManager(QObject *parent) : QObject(parent) {
 
-    database = QSqlDatabase::addDatabase("QSQLITE");
-    database.setDatabaseName("/usr/share/harbour-wunderfitz/db/heinzelliste.db");
+    // Budget of the search result cache in kilobytes
+    searchCache = new DictionarySearchCache(settings.value(settingCacheSize, 2048).toInt() * 1024);
+    searchWorker = new DictionarySearchWorker();
+    qRegisterMetaType<QVector<HeinzelnisseElement> >("QVector<HeinzelnisseElement>");
+    connect(searchWorker, SIGNAL(searchCompleted(int, QString, QString, QVector<HeinzelnisseElement>, bool)), this, SLOT(handleSearchCompleted(int, QString, QString, QVector<HeinzelnisseElement>, bool)));
+    connect(searchWorker, SIGNAL(finished()), this, SLOT(handleSearchFinished()));
+    searchPending = false;
+    currentSearchId = 0;
     dictionaryId = DictionaryModel::heinzelnisseId;
-
-    if (!database.open()) {
-       qDebug() << "Error: connection with Heinzelnisse database failed";
-    } else {
-       qDebug() << "Heinzelnisse database: Connection OK";
-    }
 }
 
 DatabaseManager::~DatabaseManager() {
 
-    qDeleteAll(*resultList);
-    resultList->clear();
-    delete resultList;
+    waitForSearch();
+    delete searchCache;
 }
 
 bool DatabaseManager::isOpen() const
 {
-    return database.isOpen();
+    // Searches use the connections of the worker thread, this one only tells whether the dictionary can be opened
+    return DictionaryConnectionPool::getConnection(dictionaryId).isOpen();
 }
 
 void DatabaseManager::updateResults(const QString &queryString) {
 
-    stopSearch();
-    searchWorker->setQueryParameters(database, dictionaryId, queryString);
+    // Completions of earlier searches are queued signals, they're ignored from now on
+    currentSearchId++;
+    // The running search is cancelled, the new one is started as soon as the worker is finished
+    if (searchWorker->isRunning()) {
+        pendingQueryString = queryString;
+        searchPending = true;
+        stopSearch();
+        return;
+    }
+    // The worker may have finished before its finished() signal arrived, a query which was waiting for it is outdated now
+    searchPending = false;
+    pendingQueryString.clear();
+    if (searchCache->lookup(dictionaryId, queryString, resultList)) {
+        searchWorker->setPreviousResults(dictionaryId, queryString, resultList);
+        emit searchCompleted(queryString);
+        return;
+    }
+    searchWorker->setQueryParameters(currentSearchId, dictionaryId, queryString);
     searchWorker->start();
 
 }
 
-QList<HeinzelnisseElement*>* DatabaseManager::getResultList() {
-    return resultList;
+bool DatabaseManager::canFetchMoreResults() const
+{
+    return !searchWorker->isRunning() && !searchPending && searchWorker->hasMoreResults();
+}
+
+void DatabaseManager::fetchMoreResults()
+{
+    // The next page is appended to the current results, the view asks again if the worker is busy
+    if (!canFetchMoreResults()) {
+        return;
+    }
+    currentSearchId++;
+    searchWorker->setFetchMoreParameters(currentSearchId);
+    searchWorker->start();
+}
+
+const QVector<HeinzelnisseElement>* DatabaseManager::getResultList() const {
+    return &resultList;
 }
 
 void DatabaseManager::setDictionaryId(const QString &dictionaryId)
 {
+    waitForSearch();
+    searchWorker->resetPreviousResults();
     this->dictionaryId = dictionaryId;
-    if (this->dictionaryId == DictionaryModel::heinzelnisseId) {
-        database = QSqlDatabase::database();
-    } else {
-        database = QSqlDatabase::database("connection" + dictionaryId);
-    }
-    if (database.open()) {
-        qDebug() << "Successfully switched to dictionary " + dictionaryId;
-    } else {
-        qDebug() << "Unable to switch to dictionary " + dictionaryId;
+    qDebug() << "Switched to dictionary " + dictionaryId;
+}
+
+void DatabaseManager::reloadDictionary(const QString &dictionaryId)
+{
+    // The importer atomically replaced the database file, an open connection still reads the old one
+    if (this->dictionaryId == dictionaryId) {
+        waitForSearch();
+        searchWorker->resetPreviousResults();
     }
+    searchCache->invalidate(dictionaryId);
+    DictionaryConnectionPool::invalidate(dictionaryId);
+    qDebug() << "Reloaded dictionary " + dictionaryId;
+}
+
+void DatabaseManager::removeDictionary(const QString &dictionaryId)
+{
+    searchCache->invalidate(dictionaryId);
+    DictionaryConnectionPool::invalidate(dictionaryId);
 }
 
 void DatabaseManager::stopSearch()
 {
-    while (searchWorker->isRunning()) {
-        searchWorker->requestInterruption();
-    }
+    // Doesn't block, the worker aborts the running statement within a few milliseconds
+    searchWorker->requestInterruption();
+}
+
+void DatabaseManager::waitForSearch()
+{
+    currentSearchId++;
+    searchPending = false;
+    searchWorker->requestInterruption();
+    searchWorker->wait();
+}
+
+int DatabaseManager::getCacheHits() const
+{
+    return searchCache->getHits();
 }
 
-void DatabaseManager::handleSearchCompleted(const QString &queryString)
+int DatabaseManager::getCacheMisses() const
 {
+    return searchCache->getMisses();
+}
+
+void DatabaseManager::handleSearchCompleted(int searchId, const QString &dictionaryId, const QString &queryString, const QVector<HeinzelnisseElement> &results, bool cacheable)
+{
+    if (searchId != currentSearchId) {
+        // Results of a search which was replaced by a newer one are discarded, they're neither shown nor cached
+        return;
+    }
+    resultList = results;
+    // Only prefix results are cached, a cached result list is continued and refined as a prefix search.
+    // They're stored for the dictionary which was searched, which is not necessarily the current one.
+    if (cacheable) {
+        searchCache->insert(dictionaryId, queryString, resultList);
+    }
     emit searchCompleted(queryString);
 }
 
+void DatabaseManager::handleSearchFinished()
+{
+    // A search started in the meantime already replaced the pending query
+    if (searchPending && !searchWorker->isRunning()) {
+        searchPending = false;
+        updateResults(pendingQueryString);
+    }
+}
@@ -22,35 +22,52 @@
 
 #include <QSqlDatabase>
 #include <QSqlQuery>
-#include <QList>
+#include <QSettings>
 #include <QString>
+#include <QVector>
 #include "heinzelnisseelement.h"
 #include "databasemanager.h"
+#include "dictionarysearchcache.h"
 #include "dictionarysearchworker.h"
 
 class DatabaseManager : public QObject {
 
     Q_OBJECT
 public:
+    static const QString settingCacheSize;
+
     DatabaseManager(QObject* parent);
     ~DatabaseManager();
     bool isOpen() const;
     void updateResults(const QString &query);
-    QList<HeinzelnisseElement*>* getResultList();
+    bool canFetchMoreResults() const;
+    void fetchMoreResults();
+    const QVector<HeinzelnisseElement>* getResultList() const;
     void setDictionaryId(const QString &dictionaryId);
+    void reloadDictionary(const QString &dictionaryId);
+    void removeDictionary(const QString &dictionaryId);
     void stopSearch();
+    int getCacheHits() const;
+    int getCacheMisses() const;
 
 signals:
     void searchCompleted(const QString &queryString);
 
 public slots:
-    void handleSearchCompleted(const QString &queryString);
+    void handleSearchCompleted(int searchId, const QString &dictionaryId, const QString &queryString, const QVector<HeinzelnisseElement> &results, bool cacheable);
+    void handleSearchFinished();
 
 private:
-    QSqlDatabase database;
-    QList<HeinzelnisseElement*>* resultList;
+    void waitForSearch();
+
+    QVector<HeinzelnisseElement> resultList;
     DictionarySearchWorker* searchWorker;
+    DictionarySearchCache* searchCache;
+    QSettings settings;
     QString dictionaryId;
+    int currentSearchId;
+    QString pendingQueryString;
+    bool searchPending;
 
 };
 
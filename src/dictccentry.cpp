@@ -0,0 +1,65 @@
+/*
+    Copyright (C) 2016-19 Sebastian J. Wolf
+
+    This file is part of Wunderfitz.
+
+    Wunderfitz is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    Wunderfitz is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Wunderfitz. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "dictccentry.h"
+
+DictCCEntry::DictCCEntry()
+{
+    id = 0;
+}
+
+int DictCCEntry::getId() const
+{
+    return id;
+}
+
+void DictCCEntry::setId(int value)
+{
+    id = value;
+}
+
+DictCCWord DictCCEntry::getLeftWord() const
+{
+    return leftWord;
+}
+
+void DictCCEntry::setLeftWord(const DictCCWord &value)
+{
+    leftWord = value;
+}
+
+DictCCWord DictCCEntry::getRightWord() const
+{
+    return rightWord;
+}
+
+void DictCCEntry::setRightWord(const DictCCWord &value)
+{
+    rightWord = value;
+}
+
+QString DictCCEntry::getCategory() const
+{
+    return category;
+}
+
+void DictCCEntry::setCategory(const QString &value)
+{
+    category = value;
+}
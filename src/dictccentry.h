@@ -0,0 +1,49 @@
+/*
+    Copyright (C) 2016-19 Sebastian J. Wolf
+
+    This file is part of Wunderfitz.
+
+    Wunderfitz is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    Wunderfitz is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Wunderfitz. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DICTCCENTRY_H
+#define DICTCCENTRY_H
+
+#include <QString>
+#include "dictccword.h"
+
+class DictCCEntry
+{
+public:
+    DictCCEntry();
+    int getId() const;
+    void setId(int value);
+
+    DictCCWord getLeftWord() const;
+    void setLeftWord(const DictCCWord &value);
+
+    DictCCWord getRightWord() const;
+    void setRightWord(const DictCCWord &value);
+
+    QString getCategory() const;
+    void setCategory(const QString &value);
+
+private:
+    int id;
+    DictCCWord leftWord;
+    DictCCWord rightWord;
+    QString category;
+};
+
+#endif // DICTCCENTRY_H
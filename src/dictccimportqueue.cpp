@@ -0,0 +1,66 @@
+/*
+    Copyright (C) 2016-19 Sebastian J. Wolf
+
+    This file is part of Wunderfitz.
+
+    Wunderfitz is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    Wunderfitz is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Wunderfitz. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "dictccimportqueue.h"
+#include <QMutexLocker>
+
+DictCCImportQueue::DictCCImportQueue(int capacity, int producerCount)
+{
+    this->capacity = capacity;
+    this->activeProducers = producerCount;
+}
+
+DictCCImportQueue::~DictCCImportQueue()
+{
+    qDeleteAll(batches);
+    batches.clear();
+}
+
+void DictCCImportQueue::enqueue(DictCCImportBatch *batch)
+{
+    QMutexLocker locker(&mutex);
+    while (batches.size() >= capacity) {
+        notFull.wait(&mutex);
+    }
+    batches.enqueue(batch);
+    notEmpty.wakeOne();
+}
+
+DictCCImportBatch *DictCCImportQueue::dequeue()
+{
+    QMutexLocker locker(&mutex);
+    while (batches.isEmpty() && activeProducers > 0) {
+        notEmpty.wait(&mutex);
+    }
+    if (batches.isEmpty()) {
+        return 0;
+    }
+    DictCCImportBatch *batch = batches.dequeue();
+    notFull.wakeOne();
+    return batch;
+}
+
+void DictCCImportQueue::producerFinished()
+{
+    QMutexLocker locker(&mutex);
+    activeProducers--;
+    if (activeProducers <= 0) {
+        notEmpty.wakeAll();
+    }
+}
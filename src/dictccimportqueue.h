@@ -0,0 +1,63 @@
+/*
+    Copyright (C) 2016-19 Sebastian J. Wolf
+
+    This file is part of Wunderfitz.
+
+    Wunderfitz is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    Wunderfitz is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Wunderfitz. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DICTCCIMPORTQUEUE_H
+#define DICTCCIMPORTQUEUE_H
+
+#include <QList>
+#include <QMutex>
+#include <QQueue>
+#include <QStringList>
+#include <QWaitCondition>
+#include "dictccentry.h"
+
+// A batch of consecutive dictionary lines travelling through the import pipeline.
+// The reader fills the raw lines, a parser replaces them by entries.
+struct DictCCImportBatch
+{
+    int sequenceNumber;
+    int firstLineNumber;
+    int lineCount;
+    qint64 bytesRead;
+    QStringList lines;
+    QList<DictCCEntry> entries;
+};
+
+// Bounded queue between two stages of the import pipeline. Producers block while the queue is full,
+// consumers block while it is empty. The queue is closed as soon as all producers have finished.
+class DictCCImportQueue
+{
+public:
+    DictCCImportQueue(int capacity, int producerCount);
+    ~DictCCImportQueue();
+
+    void enqueue(DictCCImportBatch *batch);
+    DictCCImportBatch *dequeue();
+    void producerFinished();
+
+private:
+    QMutex mutex;
+    QWaitCondition notEmpty;
+    QWaitCondition notFull;
+    QQueue<DictCCImportBatch*> batches;
+    int capacity;
+    int activeProducers;
+};
+
+#endif // DICTCCIMPORTQUEUE_H
@@ -18,28 +18,61 @@
 */
 
 #include "dictccimportworker.h"
-#include <JlCompress.h>
+#include "dictccimportqueue.h"
+#include "dictccparserworker.h"
+#include "dictccreaderworker.h"
+#include "dictionaryfuzzyindex.h"
+#include "dictionaryinfixindex.h"
+#include "dictionaryranking.h"
+#include "dictionaryvocabulary.h"
+#include <quazip.h>
+#include <quazipfile.h>
+#include <quazipfileinfo.h>
 #include <QDebug>
 #include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QList>
+#include <QMap>
 #include <QRegExp>
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QStandardPaths>
 #include <QStringList>
 #include <QStringListIterator>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+const QString DictCCImportWorker::settingArchiveCatalog = QString("import/archives");
+const QString DictCCImportWorker::settingInfixIndex = QString("import/infixIndex");
+const QString DictCCImportWorker::settingPrefixIndex = QString("import/prefixIndex");
+const QString DictCCImportWorker::settingFts5Storage = QString("import/fts5Storage");
+const int DictCCImportWorker::checkpointInterval = 50;
 
 DictCCImportWorker::DictCCImportWorker()
 {
-    currentMetadataVersion = 1;
+    currentMetadataVersion = 4;
+    sourceDirectory = QStandardPaths::writableLocation(QStandardPaths::DownloadLocation);
+    databaseDirectory = getDictionaryDirectory();
+}
+
+void DictCCImportWorker::setSourceDirectory(const QString &sourceDirectory)
+{
+    this->sourceDirectory = sourceDirectory;
+}
+
+void DictCCImportWorker::setDatabaseDirectory(const QString &databaseDirectory)
+{
+    this->databaseDirectory = databaseDirectory;
 }
 
 void DictCCImportWorker::importDictionaries()
 {
     emit statusChanged("Checking for new dictionaries...");
-    QString downloadDirectoryString = QStandardPaths::writableLocation(QStandardPaths::DownloadLocation);
-    QString tempDirectoryString = getTempDirectory();
+    QString downloadDirectoryString = sourceDirectory;
     qDebug() << "Reading from directory: " << downloadDirectoryString;
-    qDebug() << "Extracting temporarily to directory: " << tempDirectoryString;
     QStringList nameFilter("*.zip");
     QDir downloadDirectory(downloadDirectoryString);
     QStringList zipFiles = downloadDirectory.entryList(nameFilter);
@@ -50,63 +83,143 @@ void DictCCImportWorker::importDictionaries()
         QString zipArchiveFullPath = downloadDirectoryString + "/" + zipArchiveFileName;
         if (dictCCMatcher.indexIn(zipArchiveFileName, 0) != -1) {
             qDebug() << downloadDirectoryString + "/" + zipArchiveFileName + " successfully validated!";
-            QString zipArchiveExtractionDir = getDirectory(tempDirectoryString + "/" + zipArchiveFileName);
-            qDebug() << "Extracting archive " + zipArchiveFullPath + " to " + zipArchiveExtractionDir;
-            QStringList extractedFiles = JlCompress::extractDir(zipArchiveFullPath, zipArchiveExtractionDir);
-            QStringListIterator extractedFilesIterator(extractedFiles);
-            while (extractedFilesIterator.hasNext()) {
-                QString extractedFileName = extractedFilesIterator.next();
-                qDebug() << "Extracted file: " + extractedFileName;
-                readFile(extractedFileName);
-            }
-            QDir temporaryDirectory(zipArchiveExtractionDir);
-            if (temporaryDirectory.rmdir(zipArchiveExtractionDir)) {
-                qDebug() << "Temporary directory " + zipArchiveExtractionDir + " successfully deleted";
-            } else {
-                qDebug() << "Unable to delete temporary directory " + zipArchiveExtractionDir;
+            QFileInfo zipArchiveInfo(zipArchiveFullPath);
+            if (isCatalogued(zipArchiveInfo)) {
+                qDebug() << "Archive " + zipArchiveFileName + " unchanged since last import, skipping it";
+                continue;
             }
+            readArchive(zipArchiveInfo);
         }
     }
     emit importFinished();
 }
 
-void DictCCImportWorker::readFile(QString &completeFileName)
+void DictCCImportWorker::readArchive(const QFileInfo &zipArchiveInfo)
 {
-    QFile inputFile(completeFileName);
-    if (inputFile.open(QIODevice::ReadOnly))
-    {
-       QTextStream inputStream(&inputFile);
-       inputStream.setCodec("UTF-8");
-       QMap<QString,QString> dictionaryMetadata = getMetadata(inputStream);
-       if (dictionaryMetadata.contains("languages") && dictionaryMetadata.contains("timestamp")) {
-           emit statusChanged("Dict.cc dictionary found: " + dictionaryMetadata.value("languages") + " - " + dictionaryMetadata.value("timestamp"));
-           writeDictionary(inputStream, dictionaryMetadata);
-       }
-       inputFile.close();
-       if (inputFile.remove()) {
-           qDebug() << "Temporary file " + completeFileName + " successfully deleted";
-       } else {
-           qDebug() << "Unable to delete temporary file " + completeFileName;
-       }
-    } else
-    {
-        qDebug() << "Unable to open extracted file " + completeFileName;
+    // Entries are decompressed while they are imported, nothing is extracted to the file system.
+    QString zipArchiveFullPath = zipArchiveInfo.absoluteFilePath();
+    QuaZip zipArchive(zipArchiveFullPath);
+    if (!zipArchive.open(QuaZip::mdUnzip)) {
+        qDebug() << "Unable to open archive " + zipArchiveFullPath + ", error code " + QString::number(zipArchive.getZipError());
+        return;
+    }
+    bool archiveCompleted = true;
+    QStringList checksums;
+    QStringList dictionaryLanguages;
+    for (bool hasEntry = zipArchive.goToFirstFile(); hasEntry; hasEntry = zipArchive.goToNextFile()) {
+        QuaZipFileInfo64 entryInfo;
+        QString entryIdentity;
+        if (zipArchive.getCurrentFileInfo(&entryInfo)) {
+            checksums.append(QString::number(entryInfo.crc, 16));
+            entryIdentity = zipArchiveInfo.fileName() + "/" + entryInfo.name + "/" + QString::number(entryInfo.uncompressedSize) + "/" + QString::number(entryInfo.crc, 16);
+        }
+        QString entryName = zipArchive.getCurrentFileName();
+        if (entryName.endsWith("/")) {
+            continue;
+        }
+        QuaZipFile zipEntry(&zipArchive);
+        if (zipEntry.open(QIODevice::ReadOnly)) {
+            qDebug() << "Reading archive entry: " + entryName;
+            QString languages;
+            if (!readFile(zipEntry, entryIdentity, languages)) {
+                archiveCompleted = false;
+            }
+            if (!languages.isEmpty()) {
+                dictionaryLanguages.append(languages);
+            }
+            zipEntry.close();
+        } else {
+            qDebug() << "Unable to open archive entry " + entryName + ", error code " + QString::number(zipEntry.getZipError());
+            archiveCompleted = false;
+        }
+    }
+    zipArchive.close();
+    if (archiveCompleted) {
+        updateCatalog(zipArchiveInfo, checksums, dictionaryLanguages);
+    }
+}
+
+bool DictCCImportWorker::readFile(QIODevice &inputDevice, const QString &entryIdentity, QString &languages)
+{
+    qint64 bytesRead = 0;
+    QMap<QString,QString> dictionaryMetadata = getMetadata(inputDevice, bytesRead);
+    if (dictionaryMetadata.contains("languages") && dictionaryMetadata.contains("timestamp")) {
+        dictionaryMetadata.insert("archive", entryIdentity);
+        languages = dictionaryMetadata.value("languages");
+        emit statusChanged("Dict.cc dictionary found: " + dictionaryMetadata.value("languages") + " - " + dictionaryMetadata.value("timestamp"));
+        // Only the header has been decompressed so far, the rest of the entry is skipped if it's already known
+        if (isAlreadyImported(dictionaryMetadata)) {
+            qDebug() << "Dictionary " + dictionaryMetadata.value("languages") + " is up to date, skipping archive entry";
+            return true;
+        }
+        return writeDictionary(inputDevice, bytesRead, dictionaryMetadata);
     }
+    return true;
 }
 
+bool DictCCImportWorker::isCatalogued(const QFileInfo &zipArchiveInfo)
+{
+    // Archives are identified by size and modification time. If only the latter changed, the checksums from
+    // the central directory tell whether the content is still the same, the entries aren't decompressed.
+    QString catalogKey = settingArchiveCatalog + "/" + zipArchiveInfo.fileName();
+    if (!settings.contains(catalogKey + "/size")) {
+        return false;
+    }
+    if (settings.value(catalogKey + "/size").toLongLong() != zipArchiveInfo.size()) {
+        return false;
+    }
+    // Dictionaries imported with an older schema are imported again
+    if (settings.value(catalogKey + "/metadataVersion").toInt() != currentMetadataVersion) {
+        return false;
+    }
+    QStringList dictionaryLanguages = settings.value(catalogKey + "/languages").toStringList();
+    QStringListIterator dictionaryLanguagesIterator(dictionaryLanguages);
+    while (dictionaryLanguagesIterator.hasNext()) {
+        if (!QFile::exists(getDatabaseFilePath(dictionaryLanguagesIterator.next()))) {
+            return false;
+        }
+    }
+    if (settings.value(catalogKey + "/lastModified").toDateTime() == zipArchiveInfo.lastModified()) {
+        return true;
+    }
+    QStringList checksums;
+    QuaZip zipArchive(zipArchiveInfo.absoluteFilePath());
+    if (zipArchive.open(QuaZip::mdUnzip)) {
+        QListIterator<QuaZipFileInfo64> entryInfoIterator(zipArchive.getFileInfoList64());
+        while (entryInfoIterator.hasNext()) {
+            checksums.append(QString::number(entryInfoIterator.next().crc, 16));
+        }
+        zipArchive.close();
+    }
+    if (!checksums.isEmpty() && checksums == settings.value(catalogKey + "/checksums").toStringList()) {
+        settings.setValue(catalogKey + "/lastModified", zipArchiveInfo.lastModified());
+        return true;
+    }
+    return false;
+}
 
+void DictCCImportWorker::updateCatalog(const QFileInfo &zipArchiveInfo, const QStringList &checksums, const QStringList &dictionaryLanguages)
+{
+    QString catalogKey = settingArchiveCatalog + "/" + zipArchiveInfo.fileName();
+    settings.setValue(catalogKey + "/size", zipArchiveInfo.size());
+    settings.setValue(catalogKey + "/lastModified", zipArchiveInfo.lastModified());
+    settings.setValue(catalogKey + "/checksums", checksums);
+    settings.setValue(catalogKey + "/languages", dictionaryLanguages);
+    settings.setValue(catalogKey + "/metadataVersion", currentMetadataVersion);
+    qDebug() << "Archive " + zipArchiveInfo.fileName() + " added to the import catalog";
+}
 
-QMap<QString,QString> DictCCImportWorker::getMetadata(QTextStream &inputStream) {
+QMap<QString,QString> DictCCImportWorker::getMetadata(QIODevice &inputDevice, qint64 &bytesRead) {
     QMap<QString,QString> metadata;
-    if (!inputStream.atEnd()) {
-        QString firstLine = inputStream.readLine();
+    if (!inputDevice.atEnd()) {
+        QString firstLine = DictCCReaderWorker::readLine(inputDevice, bytesRead);
         QRegExp languagesMatcher("([A-Z]{2}\\-[A-Z]{2})");
         if (firstLine.contains("dict.cc") && languagesMatcher.indexIn(firstLine) != -1) {
             qDebug() << "Dictionary languages identified: " + languagesMatcher.cap(1);
             metadata.insert("languages", languagesMatcher.cap(1));
         }
-        if (!inputStream.atEnd()) {
-            QString secondLine = inputStream.readLine();
+        if (!inputDevice.atEnd()) {
+            QString secondLine = DictCCReaderWorker::readLine(inputDevice, bytesRead);
             QRegExp dateTimeMatcher("(\\d{4}\\-\\d{2}\\-\\d{2}\\s\\d{2}\\:\\d{2})");
             if (dateTimeMatcher.indexIn(secondLine) != -1) {
                 qDebug() << "Dictionary timestamp identified: " + dateTimeMatcher.cap(1);
@@ -117,23 +230,173 @@ QMap<QString,QString> DictCCImportWorker::getMetadata(QTextStream &inputStream)
     return metadata;
 }
 
-void DictCCImportWorker::writeDictionary(QTextStream &inputStream, QMap<QString, QString> &metadata)
+bool DictCCImportWorker::writeDictionary(QIODevice &inputDevice, qint64 &bytesRead, QMap<QString, QString> &metadata)
+{
+    // The dictionary is built in a shadow file which replaces the existing database only when it's complete,
+    // so searches can continue on the old database during the import.
+    QString databaseFilePath = getDatabaseFilePath(metadata.value("languages"));
+    QString shadowFilePath = databaseFilePath + ".tmp";
+    qint64 checkpointOffset = 0;
+    int checkpointEntryId = 0;
+    if (QFile::exists(shadowFilePath)) {
+        if (readCheckpoint(shadowFilePath, metadata, checkpointOffset, checkpointEntryId)) {
+            // An earlier import of the same archive entry was interrupted, continue after its last commit
+            if (!skipBytes(inputDevice, bytesRead, checkpointOffset)) {
+                qDebug() << "Unable to resume import at offset " + QString::number(checkpointOffset);
+                removeShadowDatabase(shadowFilePath);
+                return false;
+            }
+            qDebug() << "Resuming import after entry " + QString::number(checkpointEntryId);
+            emit statusChanged(metadata.value("languages") + " dictionary: Resuming import after entry " + QString::number(checkpointEntryId));
+        } else if (!removeShadowDatabase(shadowFilePath)) {
+            qDebug() << "Unable to remove outdated shadow database " + shadowFilePath;
+            return false;
+        }
+    } else if (!removeShadowDatabase(shadowFilePath)) {
+        return false;
+    }
+    bool entriesWritten = false;
+    QString connectionName = "import" + metadata.value("languages");
+    {
+        QSqlDatabase database = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+        database.setDatabaseName(shadowFilePath);
+        if (database.open()) {
+            qDebug() << "SQLite database " + shadowFilePath + " successfully opened";
+            if (checkpointEntryId == 0) {
+                writeMetadata(metadata, database);
+            }
+            entriesWritten = writeDictionaryEntries(inputDevice, bytesRead, checkpointEntryId, metadata, database);
+            database.close();
+        } else {
+            qDebug() << "Error opening SQLite database " + shadowFilePath;
+        }
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+
+    if (entriesWritten && replaceDatabase(shadowFilePath, databaseFilePath)) {
+        emit dictionaryFound(metadata.value("languages"), metadata.value("timestamp"));
+        return true;
+    }
+    removeShadowDatabase(shadowFilePath);
+    return false;
+}
+
+bool DictCCImportWorker::readCheckpoint(const QString &shadowFilePath, QMap<QString, QString> &metadata, qint64 &checkpointOffset, int &checkpointEntryId)
 {
-    QString databaseDirectory = getDirectory(QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) + "/harbour-wunderfitz");
-    QString databaseFilePath = databaseDirectory + "/" + metadata.value("languages") + ".db";
-    QSqlDatabase database = QSqlDatabase::addDatabase("QSQLITE", "connection" + metadata.value("languages"));
-    database.setDatabaseName(databaseFilePath);
-    if (database.open()) {
-        qDebug() << "SQLite database " + databaseFilePath + " successfully opened";
-        if (!isAlreadyImported(metadata, database)) {
-            writeMetadata(metadata, database);
-            writeDictionaryEntries(inputStream, metadata, database);
-            emit dictionaryFound(metadata.value("languages"), metadata.value("timestamp"));
+    bool checkpointFound = false;
+    QString connectionName = "checkpoint" + metadata.value("languages");
+    {
+        // Opened read-write, as SQLite has to roll back the journal of a batch which was interrupted before its commit
+        QSqlDatabase database = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+        database.setDatabaseName(shadowFilePath);
+        if (database.open()) {
+            QMap<QString,QString> storedValues;
+            QSqlQuery databaseQuery(database);
+            databaseQuery.prepare("select key, value from metadata");
+            if (databaseQuery.exec()) {
+                while (databaseQuery.next()) {
+                    storedValues.insert(databaseQuery.value(0).toString(), databaseQuery.value(1).toString());
+                }
+            }
+            if (!metadata.value("archive").isEmpty()
+                    && storedValues.value("checkpointArchive") == metadata.value("archive")
+                    && storedValues.value("timestamp") == metadata.value("timestamp")
+                    && storedValues.value("metadataVersion") == QString::number(currentMetadataVersion)) {
+                checkpointOffset = storedValues.value("checkpointOffset").toLongLong();
+                checkpointEntryId = storedValues.value("checkpointEntryId").toInt();
+                checkpointFound = checkpointOffset > 0 && checkpointEntryId > 0;
+            }
+            database.close();
+        }
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+    return checkpointFound;
+}
+
+bool DictCCImportWorker::removeShadowDatabase(const QString &shadowFilePath)
+{
+    // A rollback journal without its database would be applied to the next shadow database of the same name
+    QFile::remove(shadowFilePath + "-journal");
+    if (QFile::exists(shadowFilePath + "-journal")) {
+        qDebug() << "Unable to remove rollback journal of shadow database " + shadowFilePath;
+        return false;
+    }
+    return !QFile::exists(shadowFilePath) || QFile::remove(shadowFilePath);
+}
+
+void DictCCImportWorker::writeCheckpoint(QMap<QString, QString> &metadata, QSqlDatabase &database, qint64 checkpointOffset, int checkpointEntryId)
+{
+    QSqlQuery databaseQuery(database);
+    databaseQuery.prepare("insert or replace into metadata values((:key),(:value))");
+    databaseQuery.bindValue(":key", "checkpointArchive");
+    databaseQuery.bindValue(":value", metadata.value("archive"));
+    databaseQuery.exec();
+    databaseQuery.bindValue(":key", "checkpointOffset");
+    databaseQuery.bindValue(":value", QString::number(checkpointOffset));
+    databaseQuery.exec();
+    databaseQuery.bindValue(":key", "checkpointEntryId");
+    databaseQuery.bindValue(":value", QString::number(checkpointEntryId));
+    if (!databaseQuery.exec()) {
+        qDebug() << "Error writing import checkpoint - " + databaseQuery.lastError().text();
+    }
+}
+
+bool DictCCImportWorker::skipBytes(QIODevice &inputDevice, qint64 &bytesRead, qint64 targetOffset)
+{
+    // Archive entries can't be seeked, so the skipped part is decompressed, but not parsed
+    while (bytesRead < targetOffset) {
+        QByteArray skippedBytes = inputDevice.read(qMin(targetOffset - bytesRead, Q_INT64_C(65536)));
+        if (skippedBytes.isEmpty()) {
+            return false;
+        }
+        bytesRead += skippedBytes.size();
+    }
+    return true;
+}
+
+bool DictCCImportWorker::replaceDatabase(const QString &shadowFilePath, const QString &databaseFilePath)
+{
+    QFile shadowFile(shadowFilePath);
+    if (!shadowFile.open(QIODevice::ReadOnly) || ::fsync(shadowFile.handle()) != 0) {
+        qDebug() << "Unable to sync shadow database " + shadowFilePath;
+        return false;
+    }
+    shadowFile.close();
+    // rename() replaces the old database atomically, open connections keep reading the old file until they're reopened
+    if (::rename(QFile::encodeName(shadowFilePath).constData(), QFile::encodeName(databaseFilePath).constData()) != 0) {
+        qDebug() << "Unable to replace " + databaseFilePath + " by shadow database " + shadowFilePath;
+        return false;
+    }
+    int directoryHandle = ::open(QFile::encodeName(QFileInfo(databaseFilePath).absolutePath()).constData(), O_RDONLY);
+    if (directoryHandle != -1) {
+        ::fsync(directoryHandle);
+        ::close(directoryHandle);
+    }
+    qDebug() << "SQLite database " + databaseFilePath + " successfully replaced";
+    return true;
+}
+
+bool DictCCImportWorker::isAlreadyImported(QMap<QString, QString> &metadata)
+{
+    QString databaseFilePath = getDatabaseFilePath(metadata.value("languages"));
+    if (!QFile::exists(databaseFilePath)) {
+        return false;
+    }
+    bool alreadyImported = false;
+    QString connectionName = "check" + metadata.value("languages");
+    {
+        QSqlDatabase database = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+        database.setDatabaseName(databaseFilePath);
+        database.setConnectOptions("QSQLITE_OPEN_READONLY");
+        if (database.open()) {
+            alreadyImported = isAlreadyImported(metadata, database);
+            database.close();
+        } else {
+            qDebug() << "Error opening SQLite database " + databaseFilePath;
         }
-        database.close();
-    } else {
-        qDebug() << "Error opening SQLite database " + databaseFilePath;
     }
+    QSqlDatabase::removeDatabase(connectionName);
+    return alreadyImported;
 }
 
 bool DictCCImportWorker::isAlreadyImported(QMap<QString, QString> &metadata, QSqlDatabase &database)
@@ -199,105 +462,270 @@ void DictCCImportWorker::writeMetadata(QMap<QString, QString> &metadata, QSqlDat
     }
 }
 
-void DictCCImportWorker::writeDictionaryEntries(QTextStream &inputStream, QMap<QString,QString> &metadata, QSqlDatabase &database)
+bool DictCCImportWorker::writeDictionaryEntries(QIODevice &inputDevice, qint64 &bytesRead, int checkpointEntryId, QMap<QString,QString> &metadata, QSqlDatabase &database)
 {
     QSqlQuery databaseQuery(database);
-    QStringList existingTables = database.tables();
-    if (existingTables.contains("entries")) {
-        databaseQuery.prepare("drop table entries");
-        if (!databaseQuery.exec()) {
-            qDebug() << "Error removing entries table.";
-            return;
-        }
-    }
-
-    databaseQuery.prepare("create virtual table entries using fts4(id integer primary key, left_word text, left_gender text, left_other text, right_word text, right_gender text, right_other text, category text, tokenize=unicode61 \"remove_diacritics=0\")");
-    if (databaseQuery.exec()) {
+    if (createEntriesTables(database)) {
         qDebug() << "Entries table successfully created!";
     } else {
         qDebug() << "Error creating entries table!";
-        return;
+        return false;
     }
 
-    QStringList rawEntries;
-    int lineCount = 0;
-    while(!inputStream.atEnd())
-    {
-        QString newLine = inputStream.readLine();
-        if (!newLine.startsWith("#")) {
-            rawEntries.append(newLine);
-            lineCount++;
-        }
+    // Import pipeline: the reader fills batches of lines, a pool of parsers turns them into entries and
+    // this thread - the only one using the database connection - writes them in their original order.
+    // The bounded queues make fast stages wait for slow ones, so memory usage stays flat.
+    int parserCount = qMax(1, QThread::idealThreadCount() - 2);
+    DictCCImportQueue parserQueue(2 * parserCount, 1);
+    DictCCImportQueue writerQueue(2 * parserCount, parserCount);
+    DictCCReaderWorker readerWorker(&inputDevice, bytesRead, checkpointEntryId, &parserQueue);
+    QList<DictCCParserWorker*> parserWorkers;
+    for (int i = 0; i < parserCount; i++) {
+        DictCCParserWorker *parserWorker = new DictCCParserWorker(&parserQueue, &writerQueue);
+        parserWorkers.append(parserWorker);
+        parserWorker->start();
     }
-    QStringListIterator rawEntriesIterator(rawEntries);
-    int currentLineNumber = 0;
+    readerWorker.start();
+
+    qint64 totalBytes = inputDevice.size();
     int successfullyWrittenEntries = 0;
-    emit statusChanged(metadata.value("languages") + " dictionary: Importing " + QString::number(lineCount) + " entries.");
+    emit statusChanged(metadata.value("languages") + " dictionary: Importing entries...");
 
-    databaseQuery.prepare("begin transaction");
-    databaseQuery.exec();
+    // Entries are committed in chunks together with a checkpoint, so an interrupted import can be resumed
+    setBulkLoadMode(database, true);
+    QSqlQuery transactionQuery(database);
+    transactionQuery.exec("begin transaction");
+    int batchesSinceCheckpoint = 0;
 
-    databaseQuery.prepare("insert into entries values((:id),(:left_word),(:left_gender),(:left_other),(:right_word),(:right_gender),(:right_other),(:category))");
-    while (rawEntriesIterator.hasNext()) {
-        currentLineNumber++;
-        div_t divisionResult = div(currentLineNumber * 100, lineCount);
-        div_t everyXResult = div(currentLineNumber, 1000);
-        QStringList currentResult = rawEntriesIterator.next().split("\t");
-        if (currentResult.count() >= 3) {
-            databaseQuery.bindValue(":id", currentLineNumber);
-            DictCCWord leftWord = getDictCCWord(currentResult.value(0));
-            databaseQuery.bindValue(":left_word", leftWord.getWord());
-            databaseQuery.bindValue(":left_gender", leftWord.getGender());
-            databaseQuery.bindValue(":left_other", leftWord.getOptional());
-            DictCCWord rightWord = getDictCCWord(currentResult.value(1));
-            databaseQuery.bindValue(":right_word", rightWord.getWord());
-            databaseQuery.bindValue(":right_gender", rightWord.getGender());
-            databaseQuery.bindValue(":right_other", rightWord.getOptional());
-            databaseQuery.bindValue(":category", currentResult.value(2));
-            if (databaseQuery.exec()) {
-                successfullyWrittenEntries++;
-            } else {
-                qDebug() << databaseQuery.lastError().text();
+    databaseQuery.prepare("insert into " + contentTableName + " values((:id),(:left_word),(:left_gender),(:left_other),(:right_word),(:right_gender),(:right_other),(:category))");
+    QMap<int, DictCCImportBatch*> pendingBatches;
+    int nextSequenceNumber = 0;
+    DictCCImportBatch *parsedBatch;
+    while ((parsedBatch = writerQueue.dequeue()) != 0) {
+        pendingBatches.insert(parsedBatch->sequenceNumber, parsedBatch);
+        while (pendingBatches.contains(nextSequenceNumber)) {
+            DictCCImportBatch *nextBatch = pendingBatches.take(nextSequenceNumber);
+            nextSequenceNumber++;
+            QListIterator<DictCCEntry> entriesIterator(nextBatch->entries);
+            while (entriesIterator.hasNext()) {
+                DictCCEntry entry = entriesIterator.next();
+                DictCCWord leftWord = entry.getLeftWord();
+                DictCCWord rightWord = entry.getRightWord();
+                databaseQuery.bindValue(":id", entry.getId());
+                databaseQuery.bindValue(":left_word", leftWord.getWord());
+                databaseQuery.bindValue(":left_gender", leftWord.getGender());
+                databaseQuery.bindValue(":left_other", leftWord.getOptional());
+                databaseQuery.bindValue(":right_word", rightWord.getWord());
+                databaseQuery.bindValue(":right_gender", rightWord.getGender());
+                databaseQuery.bindValue(":right_other", rightWord.getOptional());
+                databaseQuery.bindValue(":category", entry.getCategory());
+                if (databaseQuery.exec()) {
+                    successfullyWrittenEntries++;
+                } else {
+                    qDebug() << databaseQuery.lastError().text();
+                }
+            }
+            int currentLineNumber = nextBatch->firstLineNumber + nextBatch->lineCount - 1;
+            int percentCompleted = totalBytes > 0 ? static_cast<int>(nextBatch->bytesRead * 100 / totalBytes) : 0;
+            emit statusChanged(QString::number(currentLineNumber) + " entries imported.\n" + QString::number(percentCompleted) + "% completed");
+            batchesSinceCheckpoint++;
+            if (batchesSinceCheckpoint == checkpointInterval) {
+                writeCheckpoint(metadata, database, nextBatch->bytesRead, currentLineNumber);
+                transactionQuery.exec("commit");
+                transactionQuery.exec("begin transaction");
+                batchesSinceCheckpoint = 0;
             }
+            delete nextBatch;
+        }
+    }
+
+    readerWorker.wait();
+    bytesRead = readerWorker.getBytesRead();
+    QListIterator<DictCCParserWorker*> parserWorkersIterator(parserWorkers);
+    while (parserWorkersIterator.hasNext()) {
+        parserWorkersIterator.next()->wait();
+    }
+    qDeleteAll(parserWorkers);
+
+    // Built in the last transaction, a resumed import builds them again
+    if (searchTableName != contentTableName) {
+        emit statusChanged(metadata.value("languages") + " dictionary: Building search index...");
+        databaseQuery.prepare("insert into " + searchTableName + "(" + searchTableName + ") values('rebuild')");
+        if (!databaseQuery.exec()) {
+            qDebug() << "Error building search index - " + databaseQuery.lastError().text();
         }
-        if (everyXResult.rem == 0) {
-            emit statusChanged(QString::number(currentLineNumber) + " of " + QString::number(lineCount) + " entries imported.\n" + QString::number(divisionResult.quot) + "% completed");
+    }
+    emit statusChanged(metadata.value("languages") + " dictionary: Building folded search index...");
+    if (!writeFoldedEntries(database)) {
+        qDebug() << "Error building folded search index";
+    }
+    // Both word indexes are built from the same vocabulary, it's collected in one pass over the entries
+    emit statusChanged(metadata.value("languages") + " dictionary: Building fuzzy search index...");
+    bool vocabularyBuilt = DictionaryVocabulary::build(database, contentTableName, QStringList() << "left_word" << "right_word");
+    if (!vocabularyBuilt || !DictionaryFuzzyIndex::build(database)) {
+        qDebug() << "Error building fuzzy search index";
+    }
+    // The infix index makes parts of compound words searchable, but it's several times larger than the fuzzy index
+    if (vocabularyBuilt && settings.value(settingInfixIndex, false).toBool()) {
+        emit statusChanged(metadata.value("languages") + " dictionary: Building infix search index...");
+        if (!DictionaryInfixIndex::build(database)) {
+            qDebug() << "Error building infix search index";
         }
     }
+    DictionaryVocabulary::drop(database);
 
-    databaseQuery.prepare("end transaction");
+    databaseQuery.prepare("delete from metadata where key in ('checkpointArchive', 'checkpointOffset', 'checkpointEntryId')");
     databaseQuery.exec();
+    transactionQuery.exec("commit");
+    setBulkLoadMode(database, false);
+
+    emit statusChanged(metadata.value("languages") + " dictionary: Optimizing search index...");
+    databaseQuery.prepare("insert into " + searchTableName + "(" + searchTableName + ") values('optimize')");
+    if (!databaseQuery.exec()) {
+        qDebug() << "Error optimizing " + searchTableName + " table - " + databaseQuery.lastError().text();
+    }
+    databaseQuery.prepare("insert into folded(folded) values('optimize')");
+    if (!databaseQuery.exec()) {
+        qDebug() << "Error optimizing folded table - " + databaseQuery.lastError().text();
+    }
 
     qDebug() << metadata.value("languages") + ": " + QString::number(successfullyWrittenEntries) + " entries imported.";
     emit statusChanged(metadata.value("languages") + " dictionary with " + QString::number(successfullyWrittenEntries) + " entries successfully imported.");
+    return true;
+}
+
+bool DictCCImportWorker::createEntriesTables(QSqlDatabase &database)
+{
+    // A resumed import continues with the schema of the interrupted one
+    QStringList existingTables = database.tables();
+    if (existingTables.contains("dictionary_entries")
+            || (!existingTables.contains("entries") && settings.value(settingFts5Storage, false).toBool())) {
+        if (createFts5EntriesTables(database)) {
+            return true;
+        }
+        qDebug() << "FTS5 isn't available, falling back to FTS4";
+    }
+    contentTableName = "entries";
+    searchTableName = "entries";
+    QSqlQuery databaseQuery(database);
+    return databaseQuery.exec("create virtual table if not exists entries using fts4(id integer primary key, left_word text, left_gender text, left_other text, right_word text, right_gender text, right_other text, category text, " + getTableOptions() + ")");
+}
+
+bool DictCCImportWorker::createFts5EntriesTables(QSqlDatabase &database)
+{
+    // The content is stored once in a plain rowid table, the FTS5 index refers to it and only covers the headwords.
+    // With detail=column, positions aren't stored, which is enough for prefix queries and bm25().
+    QSqlQuery databaseQuery(database);
+    if (!databaseQuery.exec("create table if not exists dictionary_entries(id integer primary key, left_word text, left_gender text, left_other text, right_word text, right_gender text, right_other text, category text)")) {
+        qDebug() << "Error creating dictionary_entries table - " + databaseQuery.lastError().text();
+        return false;
+    }
+    if (!databaseQuery.exec("create virtual table if not exists dictionary_search using fts5(left_word, right_word, content='dictionary_entries', content_rowid='id', " + getFts5TableOptions() + ")")) {
+        qDebug() << "Error creating dictionary_search table - " + databaseQuery.lastError().text();
+        databaseQuery.exec("drop table if exists dictionary_entries");
+        return false;
+    }
+    contentTableName = "dictionary_entries";
+    searchTableName = "dictionary_search";
+    return true;
+}
+
+bool DictCCImportWorker::writeFoldedEntries(QSqlDatabase &database)
+{
+    // Headwords without diacritics and special letters, e.g. "strasse" for "Straße" and "ovelse" for "øvelse".
+    // The document ID is the rowid of the entry. Entries which are unchanged by folding are already
+    // found by the entries table, so they're left out.
+    QSqlQuery databaseQuery(database);
+    if (!databaseQuery.exec("create virtual table if not exists folded using fts4(left_word text, right_word text, " + getTableOptions() + ")")) {
+        qDebug() << "Error creating folded table - " + databaseQuery.lastError().text();
+        return false;
+    }
+    databaseQuery.exec("delete from folded");
+
+    QSqlQuery entriesQuery(database);
+    entriesQuery.setForwardOnly(true);
+    if (!entriesQuery.exec("select rowid, left_word, right_word from " + contentTableName)) {
+        qDebug() << "Error reading entries - " + entriesQuery.lastError().text();
+        return false;
+    }
+    databaseQuery.prepare("insert into folded(docid, left_word, right_word) values (?, ?, ?)");
+    int foldedEntries = 0;
+    while (entriesQuery.next()) {
+        QString leftWord = entriesQuery.value(1).toString();
+        QString rightWord = entriesQuery.value(2).toString();
+        QString foldedLeftWord = DictionaryRanking::fold(leftWord);
+        QString foldedRightWord = DictionaryRanking::fold(rightWord);
+        if (foldedLeftWord == leftWord.toCaseFolded() && foldedRightWord == rightWord.toCaseFolded()) {
+            continue;
+        }
+        databaseQuery.addBindValue(entriesQuery.value(0));
+        databaseQuery.addBindValue(foldedLeftWord);
+        databaseQuery.addBindValue(foldedRightWord);
+        if (databaseQuery.exec()) {
+            foldedEntries++;
+        } else {
+            qDebug() << databaseQuery.lastError().text();
+        }
+    }
+    qDebug() << "Folded index: " + QString::number(foldedEntries) + " entries";
+    return true;
+}
+
+QString DictCCImportWorker::getTableOptions()
+{
+    // Every search is a prefix query. Without prefix indexes, FTS4 merges the doclists of all terms
+    // starting with a short query, which is slowest for one or two letters.
+    QString tableOptions = "tokenize=unicode61 \"remove_diacritics=0\"";
+    if (settings.value(settingPrefixIndex, true).toBool()) {
+        tableOptions.append(", prefix=\"1,2,3\"");
+    }
+    return tableOptions;
+}
+
+QString DictCCImportWorker::getFts5TableOptions()
+{
+    QString tableOptions = "detail=column, tokenize=\"unicode61 remove_diacritics 0\"";
+    if (settings.value(settingPrefixIndex, true).toBool()) {
+        tableOptions.append(", prefix='1 2 3'");
+    }
+    return tableOptions;
+}
+
+void DictCCImportWorker::setBulkLoadMode(QSqlDatabase &database, bool enabled)
+{
+    // While entries are written to the shadow file, durability is traded for speed: no syncs and a larger cache.
+    // The rollback journal is kept, so the last checkpoint survives if the application is killed.
+    // Afterwards the default settings are restored.
+    QStringList pragmas;
+    if (enabled) {
+        pragmas << "pragma cache_size = -16384" << "pragma journal_mode = truncate" << "pragma synchronous = off";
+    } else {
+        pragmas << "pragma synchronous = full" << "pragma journal_mode = delete" << "pragma cache_size = -2000";
+    }
+    QSqlQuery databaseQuery(database);
+    QStringListIterator pragmasIterator(pragmas);
+    while (pragmasIterator.hasNext()) {
+        QString pragma = pragmasIterator.next();
+        if (!databaseQuery.exec(pragma)) {
+            qDebug() << "Error executing " + pragma + " - " + databaseQuery.lastError().text();
+        }
+    }
+}
 
+QString DictCCImportWorker::getDatabaseFilePath(const QString &languages)
+{
+    return getDictionaryFilePath(languages, getDirectory(databaseDirectory));
 }
 
-DictCCWord DictCCImportWorker::getDictCCWord(QString rawWord)
+QString DictCCImportWorker::getDictionaryDirectory()
 {
-    DictCCWord dictCCWord;
-    QString realWord = rawWord;
-    QRegExp genderMatcher("(\\{.+\\})");
-    if (genderMatcher.indexIn(realWord) != -1) {
-        QString genderString = genderMatcher.cap(1);
-        genderString = genderString.replace("{", "(");
-        genderString = genderString.replace("}", ")");
-        dictCCWord.setGender(genderString);
-        realWord = realWord.remove(genderMatcher);
-    }
-    QRegExp optionalMatcher("(\\[.+\\])");
-    if (optionalMatcher.indexIn(realWord) != -1) {
-        dictCCWord.setOptional(optionalMatcher.cap(1));
-        realWord = realWord.remove(optionalMatcher);
-    }
-    dictCCWord.setWord(realWord.trimmed());
-    return dictCCWord;
+    return QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) + "/harbour-wunderfitz";
 }
 
-QString DictCCImportWorker::getTempDirectory()
+QString DictCCImportWorker::getDictionaryFilePath(const QString &dictionaryId, const QString &dictionaryDirectory)
 {
-    QString tempDirectoryString = QStandardPaths::writableLocation(QStandardPaths::TempLocation) + "/harbour-wunderfitz";
-    return getDirectory(tempDirectoryString);
+    // Imported dictionaries are named after their languages, which are their IDs as well
+    return dictionaryDirectory + "/" + dictionaryId + ".db";
 }
 
 QString DictCCImportWorker::getDirectory(const QString &directoryString)
@@ -20,12 +20,14 @@
 #ifndef DICTCCIMPORTWORKER_H
 #define DICTCCIMPORTWORKER_H
 
+#include <QFileInfo>
+#include <QIODevice>
 #include <QMap>
 #include <QThread>
+#include <QSettings>
 #include <QSqlDatabase>
 #include <QString>
-#include <QTextStream>
-#include "dictccword.h"
+#include <QStringList>
 
 class DictCCImportWorker : public QThread
 {
@@ -34,7 +36,18 @@ class DictCCImportWorker : public QThread
         importDictionaries();
     }
 public:
+    static const QString settingArchiveCatalog;
+    static const QString settingInfixIndex;
+    static const QString settingPrefixIndex;
+    static const QString settingFts5Storage;
+    static const int checkpointInterval;
+
+    static QString getDictionaryDirectory();
+    static QString getDictionaryFilePath(const QString &dictionaryId, const QString &dictionaryDirectory = getDictionaryDirectory());
+
     DictCCImportWorker();
+    void setSourceDirectory(const QString &sourceDirectory);
+    void setDatabaseDirectory(const QString &databaseDirectory);
 signals:
         void importFinished();
         void dictionaryFound(const QString &languages, const QString &timestamp);
@@ -42,16 +55,35 @@ signals:
 private:
 
     void importDictionaries();
-    void readFile(QString &completeFileName);
-    QMap<QString,QString> getMetadata(QTextStream &inputStream);
-    void writeDictionary(QTextStream &inputStream, QMap<QString,QString> &metadata);
+    void readArchive(const QFileInfo &zipArchiveInfo);
+    bool readFile(QIODevice &inputDevice, const QString &entryIdentity, QString &languages);
+    bool isCatalogued(const QFileInfo &zipArchiveInfo);
+    void updateCatalog(const QFileInfo &zipArchiveInfo, const QStringList &checksums, const QStringList &dictionaryLanguages);
+    QMap<QString,QString> getMetadata(QIODevice &inputDevice, qint64 &bytesRead);
+    bool writeDictionary(QIODevice &inputDevice, qint64 &bytesRead, QMap<QString,QString> &metadata);
+    bool readCheckpoint(const QString &shadowFilePath, QMap<QString,QString> &metadata, qint64 &checkpointOffset, int &checkpointEntryId);
+    bool removeShadowDatabase(const QString &shadowFilePath);
+    void writeCheckpoint(QMap<QString,QString> &metadata, QSqlDatabase &database, qint64 checkpointOffset, int checkpointEntryId);
+    bool skipBytes(QIODevice &inputDevice, qint64 &bytesRead, qint64 targetOffset);
+    bool replaceDatabase(const QString &shadowFilePath, const QString &databaseFilePath);
+    bool isAlreadyImported(QMap<QString,QString> &metadata);
     bool isAlreadyImported(QMap<QString,QString> &metadata, QSqlDatabase &database);
     void writeMetadata(QMap<QString,QString> &metadata, QSqlDatabase &database);
-    void writeDictionaryEntries(QTextStream &inputStream, QMap<QString,QString> &metadata, QSqlDatabase &database);
+    bool writeDictionaryEntries(QIODevice &inputDevice, qint64 &bytesRead, int checkpointEntryId, QMap<QString,QString> &metadata, QSqlDatabase &database);
+    bool createEntriesTables(QSqlDatabase &database);
+    bool createFts5EntriesTables(QSqlDatabase &database);
+    bool writeFoldedEntries(QSqlDatabase &database);
+    void setBulkLoadMode(QSqlDatabase &database, bool enabled);
+    QString getTableOptions();
+    QString getFts5TableOptions();
     int currentMetadataVersion;
-    DictCCWord getDictCCWord(QString rawWord);
-    QString getTempDirectory();
+    QString getDatabaseFilePath(const QString &languages);
     QString getDirectory(const QString &directoryString);
+    QSettings settings;
+    QString contentTableName;
+    QString searchTableName;
+    QString sourceDirectory;
+    QString databaseDirectory;
 };
 
 #endif // DICTCCIMPORTWORKER_H
@@ -0,0 +1,86 @@
+/*
+    Copyright (C) 2016-19 Sebastian J. Wolf
+
+    This file is part of Wunderfitz.
+
+    Wunderfitz is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    Wunderfitz is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Wunderfitz. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "dictccparserworker.h"
+#include <QStringList>
+
+DictCCParserWorker::DictCCParserWorker(DictCCImportQueue *parserQueue, DictCCImportQueue *writerQueue)
+{
+    this->parserQueue = parserQueue;
+    this->writerQueue = writerQueue;
+}
+
+void DictCCParserWorker::parseBatches()
+{
+    DictCCImportBatch *batch;
+    while ((batch = parserQueue->dequeue()) != 0) {
+        batch->entries.reserve(batch->lines.size());
+        for (int i = 0; i < batch->lines.size(); i++) {
+            QStringList currentResult = batch->lines.at(i).split("\t");
+            if (currentResult.count() >= 3) {
+                DictCCEntry entry;
+                entry.setId(batch->firstLineNumber + i);
+                entry.setLeftWord(getDictCCWord(currentResult.value(0)));
+                entry.setRightWord(getDictCCWord(currentResult.value(1)));
+                entry.setCategory(currentResult.value(2));
+                batch->entries.append(entry);
+            }
+        }
+        batch->lines.clear();
+        writerQueue->enqueue(batch);
+    }
+    writerQueue->producerFinished();
+}
+
+DictCCWord DictCCParserWorker::getDictCCWord(const QString &rawWord)
+{
+    DictCCWord dictCCWord;
+    QString realWord = rawWord;
+    int sectionStart;
+    int sectionLength;
+    if (findSection(realWord, QLatin1Char('{'), QLatin1Char('}'), sectionStart, sectionLength)) {
+        QString genderString = realWord.mid(sectionStart, sectionLength);
+        genderString.replace(QLatin1Char('{'), QLatin1Char('('));
+        genderString.replace(QLatin1Char('}'), QLatin1Char(')'));
+        dictCCWord.setGender(genderString);
+        realWord.remove(sectionStart, sectionLength);
+    }
+    if (findSection(realWord, QLatin1Char('['), QLatin1Char(']'), sectionStart, sectionLength)) {
+        dictCCWord.setOptional(realWord.mid(sectionStart, sectionLength));
+        realWord.remove(sectionStart, sectionLength);
+    }
+    dictCCWord.setWord(realWord.trimmed());
+    return dictCCWord;
+}
+
+bool DictCCParserWorker::findSection(const QString &text, QChar opening, QChar closing, int &sectionStart, int &sectionLength)
+{
+    // Same section as the greedy expression "\{.+\}" used to match: from the first opening to the last
+    // closing character, with at least one character in between.
+    sectionStart = text.indexOf(opening);
+    if (sectionStart == -1) {
+        return false;
+    }
+    int sectionEnd = text.lastIndexOf(closing);
+    if (sectionEnd < sectionStart + 2) {
+        return false;
+    }
+    sectionLength = sectionEnd - sectionStart + 1;
+    return true;
+}
@@ -0,0 +1,46 @@
+/*
+    Copyright (C) 2016-19 Sebastian J. Wolf
+
+    This file is part of Wunderfitz.
+
+    Wunderfitz is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    Wunderfitz is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Wunderfitz. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DICTCCPARSERWORKER_H
+#define DICTCCPARSERWORKER_H
+
+#include <QString>
+#include <QThread>
+#include "dictccimportqueue.h"
+#include "dictccword.h"
+
+class DictCCParserWorker : public QThread
+{
+    Q_OBJECT
+    void run() Q_DECL_OVERRIDE {
+        parseBatches();
+    }
+public:
+    DictCCParserWorker(DictCCImportQueue *parserQueue, DictCCImportQueue *writerQueue);
+    static DictCCWord getDictCCWord(const QString &rawWord);
+    static bool findSection(const QString &text, QChar opening, QChar closing, int &sectionStart, int &sectionLength);
+
+private:
+    DictCCImportQueue *parserQueue;
+    DictCCImportQueue *writerQueue;
+
+    void parseBatches();
+};
+
+#endif // DICTCCPARSERWORKER_H
@@ -0,0 +1,82 @@
+/*
+    Copyright (C) 2016-19 Sebastian J. Wolf
+
+    This file is part of Wunderfitz.
+
+    Wunderfitz is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    Wunderfitz is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Wunderfitz. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "dictccreaderworker.h"
+#include <QByteArray>
+
+const int DictCCReaderWorker::batchSize = 1000;
+
+DictCCReaderWorker::DictCCReaderWorker(QIODevice *inputDevice, qint64 bytesRead, int lineNumber, DictCCImportQueue *parserQueue)
+{
+    this->inputDevice = inputDevice;
+    this->bytesRead = bytesRead;
+    this->lineNumber = lineNumber;
+    this->parserQueue = parserQueue;
+}
+
+qint64 DictCCReaderWorker::getBytesRead() const
+{
+    return bytesRead;
+}
+
+QString DictCCReaderWorker::readLine(QIODevice &inputDevice, qint64 &bytesRead)
+{
+    QByteArray rawLine = inputDevice.readLine();
+    bytesRead += rawLine.size();
+    if (rawLine.endsWith('\n')) {
+        rawLine.chop(1);
+        if (rawLine.endsWith('\r')) {
+            rawLine.chop(1);
+        }
+    }
+    return QString::fromUtf8(rawLine);
+}
+
+void DictCCReaderWorker::readBatches()
+{
+    int sequenceNumber = 0;
+    int currentLineNumber = lineNumber;
+    DictCCImportBatch *batch = 0;
+    while (!inputDevice->atEnd()) {
+        QString newLine = readLine(*inputDevice, bytesRead);
+        if (newLine.startsWith("#")) {
+            continue;
+        }
+        if (batch == 0) {
+            batch = new DictCCImportBatch();
+            batch->sequenceNumber = sequenceNumber++;
+            batch->firstLineNumber = currentLineNumber + 1;
+            batch->lineCount = 0;
+            batch->lines.reserve(batchSize);
+        }
+        currentLineNumber++;
+        batch->lines.append(newLine);
+        batch->lineCount++;
+        if (batch->lineCount == batchSize) {
+            batch->bytesRead = bytesRead;
+            parserQueue->enqueue(batch);
+            batch = 0;
+        }
+    }
+    if (batch != 0) {
+        batch->bytesRead = bytesRead;
+        parserQueue->enqueue(batch);
+    }
+    parserQueue->producerFinished();
+}
@@ -0,0 +1,50 @@
+/*
+    Copyright (C) 2016-19 Sebastian J. Wolf
+
+    This file is part of Wunderfitz.
+
+    Wunderfitz is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    Wunderfitz is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Wunderfitz. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DICTCCREADERWORKER_H
+#define DICTCCREADERWORKER_H
+
+#include <QIODevice>
+#include <QString>
+#include <QThread>
+#include "dictccimportqueue.h"
+
+class DictCCReaderWorker : public QThread
+{
+    Q_OBJECT
+    void run() Q_DECL_OVERRIDE {
+        readBatches();
+    }
+public:
+    DictCCReaderWorker(QIODevice *inputDevice, qint64 bytesRead, int lineNumber, DictCCImportQueue *parserQueue);
+    qint64 getBytesRead() const;
+
+    static QString readLine(QIODevice &inputDevice, qint64 &bytesRead);
+    static const int batchSize;
+
+private:
+    QIODevice *inputDevice;
+    qint64 bytesRead;
+    int lineNumber;
+    DictCCImportQueue *parserQueue;
+
+    void readBatches();
+};
+
+#endif // DICTCCREADERWORKER_H
@@ -0,0 +1,125 @@
+/*
+    Copyright (C) 2016-19 Sebastian J. Wolf
+
+    This file is part of Wunderfitz.
+
+    Wunderfitz is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    Wunderfitz is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Wunderfitz. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "dictionaryconnectionpool.h"
+#include "dictccimportworker.h"
+#include "dictionarymodel.h"
+#include "dictionaryranking.h"
+#include <QDebug>
+#include <QListIterator>
+#include <QMutexLocker>
+#include <QSqlError>
+#include <QStringList>
+#include <QThread>
+#include <QUrl>
+
+QMutex DictionaryConnectionPool::mutex;
+QHash<QString, int> DictionaryConnectionPool::dictionaryGenerations;
+QHash<QString, int> DictionaryConnectionPool::connectionGenerations;
+
+QSqlDatabase DictionaryConnectionPool::getConnection(const QString &dictionaryId)
+{
+    // Qt connections must only be used by the thread which created them, so each thread gets its own ones
+    QString connectionName = "search" + dictionaryId + getThreadSuffix();
+    int dictionaryGeneration = getDictionaryGeneration(dictionaryId);
+    if (QSqlDatabase::contains(connectionName)) {
+        if (!isStale(connectionName, dictionaryGeneration)) {
+            return QSqlDatabase::database(connectionName, false);
+        }
+        removeConnection(connectionName);
+    }
+
+    // Dictionaries are never modified in place, the importer replaces the whole file.
+    // An open connection keeps reading the old file, so SQLite can skip all locking and change detection.
+    QSqlDatabase database = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+    database.setDatabaseName(QUrl::fromLocalFile(getDatabaseFilePath(dictionaryId)).toString() + "?immutable=1");
+    database.setConnectOptions("QSQLITE_OPEN_READONLY;QSQLITE_OPEN_URI");
+    if (database.open()) {
+        // Functions are registered per SQLite handle
+        DictionaryRanking::registerFunctions(database);
+        qDebug() << "Opened search connection " + connectionName;
+    } else {
+        qDebug() << "Unable to open search connection " + connectionName + " - " + database.lastError().text();
+    }
+    QMutexLocker locker(&mutex);
+    connectionGenerations.insert(connectionName, dictionaryGeneration);
+    return database;
+}
+
+void DictionaryConnectionPool::invalidate(const QString &dictionaryId)
+{
+    // Connections of the other threads are replaced the next time they're used
+    QMutexLocker locker(&mutex);
+    dictionaryGenerations.insert(dictionaryId, dictionaryGenerations.value(dictionaryId) + 1);
+}
+
+void DictionaryConnectionPool::releaseStaleConnections()
+{
+    // Closes connections of the calling thread to dictionaries which were replaced or deleted in the meantime
+    QString threadSuffix = getThreadSuffix();
+    QStringList connectionNames = QSqlDatabase::connectionNames();
+    QListIterator<QString> connectionIterator(connectionNames);
+    while (connectionIterator.hasNext()) {
+        QString connectionName = connectionIterator.next();
+        if (!connectionName.startsWith("search") || !connectionName.endsWith(threadSuffix)) {
+            continue;
+        }
+        QString dictionaryId = connectionName.mid(6, connectionName.length() - 6 - threadSuffix.length());
+        if (isStale(connectionName, getDictionaryGeneration(dictionaryId))) {
+            removeConnection(connectionName);
+        }
+    }
+}
+
+QString DictionaryConnectionPool::getDatabaseFilePath(const QString &dictionaryId)
+{
+    if (dictionaryId == DictionaryModel::heinzelnisseId) {
+        return QString("/usr/share/harbour-wunderfitz/db/heinzelliste.db");
+    }
+    return DictCCImportWorker::getDictionaryFilePath(dictionaryId);
+}
+
+QString DictionaryConnectionPool::getThreadSuffix()
+{
+    return "@" + QString::number(reinterpret_cast<quintptr>(QThread::currentThread()), 16);
+}
+
+int DictionaryConnectionPool::getDictionaryGeneration(const QString &dictionaryId)
+{
+    QMutexLocker locker(&mutex);
+    return dictionaryGenerations.value(dictionaryId);
+}
+
+bool DictionaryConnectionPool::isStale(const QString &connectionName, int dictionaryGeneration)
+{
+    QMutexLocker locker(&mutex);
+    return connectionGenerations.value(connectionName, -1) != dictionaryGeneration;
+}
+
+void DictionaryConnectionPool::removeConnection(const QString &connectionName)
+{
+    {
+        QSqlDatabase database = QSqlDatabase::database(connectionName, false);
+        database.close();
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+    QMutexLocker locker(&mutex);
+    connectionGenerations.remove(connectionName);
+    qDebug() << "Closed search connection " + connectionName;
+}
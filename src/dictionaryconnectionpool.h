@@ -0,0 +1,47 @@
+/*
+    Copyright (C) 2016-19 Sebastian J. Wolf
+
+    This file is part of Wunderfitz.
+
+    Wunderfitz is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    Wunderfitz is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Wunderfitz. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DICTIONARYCONNECTIONPOOL_H
+#define DICTIONARYCONNECTIONPOOL_H
+
+#include <QHash>
+#include <QMutex>
+#include <QSqlDatabase>
+#include <QString>
+
+class DictionaryConnectionPool
+{
+public:
+    static QSqlDatabase getConnection(const QString &dictionaryId);
+    static void invalidate(const QString &dictionaryId);
+    static void releaseStaleConnections();
+    static QString getDatabaseFilePath(const QString &dictionaryId);
+
+private:
+    static QMutex mutex;
+    static QHash<QString, int> dictionaryGenerations;
+    static QHash<QString, int> connectionGenerations;
+
+    static QString getThreadSuffix();
+    static int getDictionaryGeneration(const QString &dictionaryId);
+    static bool isStale(const QString &connectionName, int dictionaryGeneration);
+    static void removeConnection(const QString &connectionName);
+};
+
+#endif // DICTIONARYCONNECTIONPOOL_H
@@ -0,0 +1,206 @@
+/*
+    Copyright (C) 2016-19 Sebastian J. Wolf
+
+    This file is part of Wunderfitz.
+
+    Wunderfitz is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    Wunderfitz is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Wunderfitz. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "dictionaryfuzzyindex.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QMap>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QVector>
+#include <algorithm>
+
+const int DictionaryFuzzyIndex::prefixLength = 7;
+const int DictionaryFuzzyIndex::minimumWordLength = 4;
+const int DictionaryFuzzyIndex::maximumDistance = 2;
+const int DictionaryFuzzyIndex::searchBudget = 20;
+
+namespace {
+
+bool isLongerDeletion(const QString &firstDeletion, const QString &secondDeletion)
+{
+    return firstDeletion.length() > secondDeletion.length();
+}
+
+}
+
+bool DictionaryFuzzyIndex::build(QSqlDatabase &database)
+{
+    QSqlQuery databaseQuery(database);
+    if (!databaseQuery.exec("create table if not exists fuzzy(deletion text not null, word text not null, primary key(deletion, word)) without rowid")) {
+        qDebug() << "Error creating fuzzy table - " + databaseQuery.lastError().text();
+        return false;
+    }
+    // A resumed import builds the index again from scratch
+    databaseQuery.exec("delete from fuzzy");
+
+    // The words are streamed from the vocabulary collected by DictionaryVocabulary.
+    // Both sides store deletions up to the maximum distance, otherwise two substitutions wouldn't meet.
+    // Longer words are only indexed by their prefix, the candidates are verified against the whole word.
+    databaseQuery.prepare("insert or ignore into fuzzy values (?, ?)");
+    QSqlQuery wordsQuery(database);
+    wordsQuery.setForwardOnly(true);
+    if (!wordsQuery.exec("select word from vocabulary")) {
+        qDebug() << "Error reading the vocabulary - " + wordsQuery.lastError().text();
+        return false;
+    }
+    int indexedWords = 0;
+    int writtenDeletions = 0;
+    while (wordsQuery.next()) {
+        QString word = wordsQuery.value(0).toString();
+        indexedWords++;
+        QSet<QString> deletions;
+        deletions.insert(word.left(prefixLength));
+        addDeletions(word.left(prefixLength), maximumDistance, deletions);
+        QSetIterator<QString> deletionsIterator(deletions);
+        while (deletionsIterator.hasNext()) {
+            databaseQuery.addBindValue(deletionsIterator.next());
+            databaseQuery.addBindValue(word);
+            if (databaseQuery.exec()) {
+                writtenDeletions++;
+            } else {
+                qDebug() << databaseQuery.lastError().text();
+            }
+        }
+    }
+    qDebug() << "Fuzzy index: " + QString::number(indexedWords) + " words, " + QString::number(writtenDeletions) + " deletions";
+    return true;
+}
+
+bool DictionaryFuzzyIndex::isAvailable(QSqlDatabase &database)
+{
+    return database.tables().contains("fuzzy");
+}
+
+QStringList DictionaryFuzzyIndex::findCandidates(QSqlDatabase &database, const QString &queryString, int maximumCandidates)
+{
+    QElapsedTimer searchTimer;
+    searchTimer.start();
+    QStringList candidates;
+    QString foldedQuery = queryString.toCaseFolded();
+    if (foldedQuery.length() < minimumWordLength) {
+        return candidates;
+    }
+
+    // Deletions with fewer removed characters are looked up first, they lead to the closest words
+    QSet<QString> deletions;
+    deletions.insert(foldedQuery.left(prefixLength));
+    addDeletions(foldedQuery.left(prefixLength), maximumDistance, deletions);
+    QStringList sortedDeletions = deletions.toList();
+    std::stable_sort(sortedDeletions.begin(), sortedDeletions.end(), isLongerDeletion);
+
+    // Words are scored by their distance to the query, matching the whole word beats matching the beginning
+    QMap<int, QStringList> scoredWords;
+    QSet<QString> checkedWords;
+    QSqlQuery databaseQuery(database);
+    databaseQuery.setForwardOnly(true);
+    databaseQuery.prepare("select word from fuzzy where deletion = ?");
+    for (int i = 0; i < sortedDeletions.size() && searchTimer.elapsed() < searchBudget; i++) {
+        databaseQuery.addBindValue(sortedDeletions.at(i));
+        if (!databaseQuery.exec()) {
+            qDebug() << "Unable to query fuzzy index - " + databaseQuery.lastError().text();
+            break;
+        }
+        while (databaseQuery.next()) {
+            QString word = databaseQuery.value(0).toString();
+            if (checkedWords.contains(word)) {
+                continue;
+            }
+            checkedWords.insert(word);
+            int wordDistance = getEditDistance(foldedQuery, word);
+            int prefixDistance = getEditDistance(foldedQuery, word.left(foldedQuery.length()));
+            if (wordDistance <= maximumDistance) {
+                scoredWords[2 * wordDistance].append(word);
+            } else if (prefixDistance <= maximumDistance) {
+                scoredWords[2 * prefixDistance + 1].append(word);
+            }
+        }
+    }
+
+    QMapIterator<int, QStringList> scoredWordsIterator(scoredWords);
+    while (scoredWordsIterator.hasNext() && candidates.size() < maximumCandidates) {
+        candidates.append(scoredWordsIterator.next().value().mid(0, maximumCandidates - candidates.size()));
+    }
+    qDebug() << "Fuzzy candidates for " + queryString + ": " + candidates.join(", ") + " after " + QString::number(searchTimer.elapsed()) + " ms";
+    return candidates;
+}
+
+QStringList DictionaryFuzzyIndex::getWords(const QString &text)
+{
+    // Same word boundaries as the unicode61 tokenizer, case folded like the FTS index
+    QStringList words;
+    QString foldedText = text.toCaseFolded();
+    int wordStart = -1;
+    for (int i = 0; i <= foldedText.length(); i++) {
+        bool isWordCharacter = i < foldedText.length() && (foldedText.at(i).isLetterOrNumber() || foldedText.at(i).isMark());
+        if (isWordCharacter && wordStart == -1) {
+            wordStart = i;
+        } else if (!isWordCharacter && wordStart != -1) {
+            if (i - wordStart >= minimumWordLength) {
+                words.append(foldedText.mid(wordStart, i - wordStart));
+            }
+            wordStart = -1;
+        }
+    }
+    return words;
+}
+
+void DictionaryFuzzyIndex::addDeletions(const QString &word, int distance, QSet<QString> &deletions)
+{
+    if (distance == 0 || word.length() <= 1) {
+        return;
+    }
+    for (int i = 0; i < word.length(); i++) {
+        QString deletion = QString(word).remove(i, 1);
+        if (!deletions.contains(deletion)) {
+            deletions.insert(deletion);
+            addDeletions(deletion, distance - 1, deletions);
+        }
+    }
+}
+
+int DictionaryFuzzyIndex::getEditDistance(const QString &firstWord, const QString &secondWord)
+{
+    // Optimal string alignment distance, transposed characters count as one edit
+    int firstLength = firstWord.length();
+    int secondLength = secondWord.length();
+    if (qAbs(firstLength - secondLength) > maximumDistance) {
+        return maximumDistance + 1;
+    }
+    QVector<int> previousPreviousRow(secondLength + 1);
+    QVector<int> previousRow(secondLength + 1);
+    QVector<int> currentRow(secondLength + 1);
+    for (int j = 0; j <= secondLength; j++) {
+        previousRow[j] = j;
+    }
+    for (int i = 1; i <= firstLength; i++) {
+        currentRow[0] = i;
+        for (int j = 1; j <= secondLength; j++) {
+            int substitutionCost = (firstWord.at(i - 1) == secondWord.at(j - 1)) ? 0 : 1;
+            int distance = qMin(qMin(previousRow[j] + 1, currentRow[j - 1] + 1), previousRow[j - 1] + substitutionCost);
+            if (i > 1 && j > 1 && firstWord.at(i - 1) == secondWord.at(j - 2) && firstWord.at(i - 2) == secondWord.at(j - 1)) {
+                distance = qMin(distance, previousPreviousRow[j - 2] + 1);
+            }
+            currentRow[j] = distance;
+        }
+        previousPreviousRow = previousRow;
+        previousRow = currentRow;
+    }
+    return previousRow[secondLength];
+}
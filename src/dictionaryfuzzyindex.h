@@ -0,0 +1,49 @@
+/*
+    Copyright (C) 2016-19 Sebastian J. Wolf
+
+    This file is part of Wunderfitz.
+
+    Wunderfitz is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    Wunderfitz is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Wunderfitz. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DICTIONARYFUZZYINDEX_H
+#define DICTIONARYFUZZYINDEX_H
+
+#include <QSet>
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+
+// Typo-tolerant lookup of headwords, based on the symmetric delete algorithm (SymSpell).
+// The importer stores each word of the vocabulary under its prefix and all deletions of up to two characters
+// of the prefix. A search generates the same deletions of the query, so only indexed lookups are needed.
+class DictionaryFuzzyIndex
+{
+public:
+    static const int prefixLength;
+    static const int minimumWordLength;
+    static const int maximumDistance;
+    static const int searchBudget;
+
+    static bool build(QSqlDatabase &database);
+    static bool isAvailable(QSqlDatabase &database);
+    static QStringList findCandidates(QSqlDatabase &database, const QString &queryString, int maximumCandidates);
+    static QStringList getWords(const QString &text);
+
+private:
+    static void addDeletions(const QString &word, int distance, QSet<QString> &deletions);
+    static int getEditDistance(const QString &firstWord, const QString &secondWord);
+};
+
+#endif // DICTIONARYFUZZYINDEX_H
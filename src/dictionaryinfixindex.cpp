@@ -0,0 +1,113 @@
+/*
+    Copyright (C) 2016-19 Sebastian J. Wolf
+
+    This file is part of Wunderfitz.
+
+    Wunderfitz is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    Wunderfitz is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Wunderfitz. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "dictionaryinfixindex.h"
+#include <QDebug>
+#include <QSqlError>
+#include <QSqlQuery>
+
+const int DictionaryInfixIndex::trigramLength = 3;
+const int DictionaryInfixIndex::maximumWords = 50;
+
+bool DictionaryInfixIndex::build(QSqlDatabase &database)
+{
+    QSqlQuery databaseQuery(database);
+    if (!databaseQuery.exec("create table if not exists infix(trigram text not null, word text not null, primary key(trigram, word)) without rowid")) {
+        qDebug() << "Error creating infix table - " + databaseQuery.lastError().text();
+        return false;
+    }
+    // A resumed import builds the index again from scratch
+    databaseQuery.exec("delete from infix");
+
+    // Same vocabulary as the fuzzy index, collected once by DictionaryVocabulary
+    databaseQuery.prepare("insert or ignore into infix values (?, ?)");
+    QSqlQuery wordsQuery(database);
+    wordsQuery.setForwardOnly(true);
+    if (!wordsQuery.exec("select word from vocabulary")) {
+        qDebug() << "Error reading the vocabulary - " + wordsQuery.lastError().text();
+        return false;
+    }
+    int indexedWords = 0;
+    int writtenTrigrams = 0;
+    while (wordsQuery.next()) {
+        QString word = wordsQuery.value(0).toString();
+        indexedWords++;
+        for (int i = 0; i + trigramLength <= word.length(); i++) {
+            databaseQuery.addBindValue(word.mid(i, trigramLength));
+            databaseQuery.addBindValue(word);
+            if (databaseQuery.exec()) {
+                writtenTrigrams++;
+            } else {
+                qDebug() << databaseQuery.lastError().text();
+            }
+        }
+    }
+    qDebug() << "Infix index: " + QString::number(indexedWords) + " words, " + QString::number(writtenTrigrams) + " trigrams";
+    return true;
+}
+
+bool DictionaryInfixIndex::isAvailable(QSqlDatabase &database)
+{
+    return database.tables().contains("infix");
+}
+
+QStringList DictionaryInfixIndex::findWords(QSqlDatabase &database, const QString &queryString)
+{
+    QStringList infixWords;
+    QString foldedQuery = queryString.toCaseFolded();
+    if (foldedQuery.length() < trigramLength) {
+        return infixWords;
+    }
+
+    // The first, middle and last trigram narrow the candidates down, the remaining ones are checked in memory
+    QStringList trigrams;
+    int lastPosition = foldedQuery.length() - trigramLength;
+    trigrams.append(foldedQuery.mid(0, trigramLength));
+    if (lastPosition > 1) {
+        trigrams.append(foldedQuery.mid(lastPosition / 2, trigramLength));
+    }
+    if (lastPosition > 0) {
+        trigrams.append(foldedQuery.mid(lastPosition, trigramLength));
+    }
+    trigrams.removeDuplicates();
+    QStringList trigramQueries;
+    for (int i = 0; i < trigrams.size(); i++) {
+        trigramQueries.append("select word from infix where trigram = ?");
+    }
+    QSqlQuery databaseQuery(database);
+    databaseQuery.setForwardOnly(true);
+    databaseQuery.prepare(trigramQueries.join(" intersect "));
+    for (int i = 0; i < trigrams.size(); i++) {
+        databaseQuery.addBindValue(trigrams.at(i));
+    }
+    if (!databaseQuery.exec()) {
+        qDebug() << "Unable to query infix index - " + databaseQuery.lastError().text();
+        return infixWords;
+    }
+
+    // Words starting with the query are already found by the prefix query
+    while (databaseQuery.next() && infixWords.size() < maximumWords) {
+        QString word = databaseQuery.value(0).toString();
+        int position = word.indexOf(foldedQuery);
+        if (position > 0) {
+            infixWords.append(word);
+        }
+    }
+    return infixWords;
+}
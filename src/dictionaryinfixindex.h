@@ -0,0 +1,41 @@
+/*
+    Copyright (C) 2016-19 Sebastian J. Wolf
+
+    This file is part of Wunderfitz.
+
+    Wunderfitz is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    Wunderfitz is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Wunderfitz. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DICTIONARYINFIXINDEX_H
+#define DICTIONARYINFIXINDEX_H
+
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+
+// Optional index of all trigrams of the headwords, so that parts of compound words can be found.
+// The FTS index only supports prefix queries, the words containing a query are looked up here and
+// added to the FTS query.
+class DictionaryInfixIndex
+{
+public:
+    static const int trigramLength;
+    static const int maximumWords;
+
+    static bool build(QSqlDatabase &database);
+    static bool isAvailable(QSqlDatabase &database);
+    static QStringList findWords(QSqlDatabase &database, const QString &queryString);
+};
+
+#endif // DICTIONARYINFIXINDEX_H
@@ -18,6 +18,8 @@
 */
 
 #include "dictionarymodel.h"
+#include "dictccimportworker.h"
+#include "dictionaryconnectionpool.h"
 
 const QString DictionaryModel::settingDictionaryId = QString("dictionary/id");
 const QString DictionaryModel::settingRemainingHints = QString("ui/remainingHints");
@@ -29,7 +31,6 @@ const QString DictionaryModel::heinzelnisseTimestamp = QString("2017-01-07 12:48
 #include <QDir>
 #include <QSqlError>
 #include <QSqlQuery>
-#include <QStandardPaths>
 #include <QString>
 #include <QStringList>
 
@@ -38,6 +39,7 @@ DictionaryModel::DictionaryModel()
     initializeDatabases();
     DictCCImporterModel* myModel (&dictCCImporterModel);
     connect(myModel, SIGNAL(importFinished()), this, SLOT(handleModelChanged()));
+    connect(myModel, SIGNAL(dictionaryFound(QString,QString)), this, SLOT(handleDictionaryImported(QString,QString)));
 }
 
 QVariant DictionaryModel::data(const QModelIndex &index, int role) const {
@@ -102,7 +104,7 @@ void DictionaryModel::initializeDatabases()
     availableDictionaries.append(heinzelnisseMetadata);
 
     QStringList nameFilter("*.db");
-    QString databaseDirectory = QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) + "/harbour-wunderfitz";
+    QString databaseDirectory = DictCCImportWorker::getDictionaryDirectory();
     QDir downloadDirectory(databaseDirectory);
     QStringList databaseFiles = downloadDirectory.entryList(nameFilter);
     QStringListIterator databaseFilesIterator(databaseFiles);
@@ -159,9 +161,10 @@ void DictionaryModel::deleteSelectedDictionary()
         selectDictionary(newIndex);
         QSqlDatabase databaseToDelete = QSqlDatabase::database("connection" + idToDelete);
         databaseToDelete.close();
-        QFile fileToDelete(QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) + "/harbour-wunderfitz" + "/" + idToDelete + ".db");
+        QFile fileToDelete(DictionaryConnectionPool::getDatabaseFilePath(idToDelete));
         if (fileToDelete.remove()) {
             qDebug() << "Dictionary deleted: " + idToDelete;
+            heinzelnisseModel.removeDictionary(idToDelete);
             selectedIndex = newIndex;
             handleModelChanged();
         } else {
@@ -217,6 +220,12 @@ void DictionaryModel::handleModelChanged()
     emit dictionaryChanged();
 }
 
+void DictionaryModel::handleDictionaryImported(const QString &languages, const QString &timestamp)
+{
+    qDebug() << "Dictionary " + languages + " was replaced by version " + timestamp;
+    heinzelnisseModel.reloadDictionary(languages);
+}
+
 int DictionaryModel::rowCount(const QModelIndex&) const {
     return availableDictionaries.size();
 }
@@ -57,6 +57,7 @@ public:
 
 public slots:
     void handleModelChanged();
+    void handleDictionaryImported(const QString &languages, const QString &timestamp);
 
 signals:
     void dictionaryChanged();
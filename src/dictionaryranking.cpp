@@ -0,0 +1,193 @@
+/*
+    Copyright (C) 2016-19 Sebastian J. Wolf
+
+    This file is part of Wunderfitz.
+
+    Wunderfitz is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    Wunderfitz is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Wunderfitz. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "dictionaryranking.h"
+#include <QChar>
+#include <QDebug>
+#include <QSqlDriver>
+#include <QVariant>
+#include <sqlite3.h>
+
+namespace {
+
+// Base characters of the Latin ranges, e.g. 'a' for 'ä' and 'å', taken from the canonical decompositions
+class BaseCharacterTable
+{
+public:
+    static const int size = 0x250;
+
+    BaseCharacterTable() {
+        for (int i = 0; i < size; i++) {
+            QChar character(i);
+            while (character.decompositionTag() == QChar::Canonical && !character.decomposition().isEmpty()) {
+                character = character.decomposition().at(0);
+            }
+            baseCharacters[i] = character.unicode();
+        }
+    }
+
+    ushort baseCharacters[size];
+};
+
+const BaseCharacterTable baseCharacterTable;
+
+// wf_rank(left_word, right_word, folded_query) - the texts are used in SQLite's UTF-16 representation without copying them.
+// The query is folded once by the caller, see DictionaryRanking::fold().
+void rankFunction(sqlite3_context *context, int argumentCount, sqlite3_value **arguments)
+{
+    if (argumentCount != 3) {
+        sqlite3_result_error(context, "wf_rank() expects three arguments", -1);
+        return;
+    }
+    const ushort *texts[3];
+    int lengths[3];
+    for (int i = 0; i < 3; i++) {
+        texts[i] = static_cast<const ushort *>(sqlite3_value_text16(arguments[i]));
+        lengths[i] = texts[i] ? sqlite3_value_bytes16(arguments[i]) / 2 : 0;
+    }
+    sqlite3_result_int(context, DictionaryRanking::getTier(texts[0], lengths[0], texts[1], lengths[1], texts[2], lengths[2]));
+}
+
+}
+
+int DictionaryRanking::getTier(const QString &leftWord, const QString &rightWord, const QString &foldedQuery)
+{
+    return getTier(leftWord.utf16(), leftWord.length(), rightWord.utf16(), rightWord.length(), foldedQuery.utf16(), foldedQuery.length());
+}
+
+int DictionaryRanking::getTier(const ushort *leftWord, int leftLength, const ushort *rightWord, int rightLength, const ushort *foldedQuery, int queryLength)
+{
+    // Diacritics and case are ignored, so that rows found by the folded index are ranked like all others.
+    // Only the headwords are folded here, the folded texts are kept on the stack as headwords rarely exceed the buffer.
+    FoldedText foldedLeft;
+    FoldedText foldedRight;
+    appendFolded(leftWord, leftLength, foldedLeft);
+    appendFolded(rightWord, rightLength, foldedRight);
+    leftWord = foldedLeft.constData();
+    leftLength = foldedLeft.size();
+    rightWord = foldedRight.constData();
+    rightLength = foldedRight.size();
+
+    if (isWordMatch(leftWord, leftLength, foldedQuery, queryLength) || isWordMatch(rightWord, rightLength, foldedQuery, queryLength)) {
+        return WordMatch;
+    }
+    if (isDirectMatch(leftWord, leftLength, foldedQuery, queryLength) || isDirectMatch(rightWord, rightLength, foldedQuery, queryLength)) {
+        return DirectMatch;
+    }
+    if (isIndirectMatch(leftWord, leftLength, foldedQuery, queryLength) || isIndirectMatch(rightWord, rightLength, foldedQuery, queryLength)) {
+        return IndirectMatch;
+    }
+    return OtherMatch;
+}
+
+bool DictionaryRanking::registerFunctions(QSqlDatabase &database)
+{
+    QVariant driverHandle = database.driver()->handle();
+    if (!driverHandle.isValid() || qstrcmp(driverHandle.typeName(), "sqlite3*") != 0) {
+        qDebug() << "Unable to register ranking function, no SQLite connection";
+        return false;
+    }
+    sqlite3 *sqliteHandle = *static_cast<sqlite3 **>(driverHandle.data());
+    if (sqliteHandle == 0) {
+        return false;
+    }
+    int functionFlags = SQLITE_UTF16;
+#ifdef SQLITE_DETERMINISTIC
+    functionFlags |= SQLITE_DETERMINISTIC;
+#endif
+    if (sqlite3_create_function_v2(sqliteHandle, "wf_rank", 3, functionFlags, 0, &rankFunction, 0, 0, 0) != SQLITE_OK) {
+        qDebug() << "Unable to register ranking function - " + QString::fromUtf8(sqlite3_errmsg(sqliteHandle));
+        return false;
+    }
+    return true;
+}
+
+QString DictionaryRanking::fold(const QString &text)
+{
+    FoldedText foldedText;
+    appendFolded(text.utf16(), text.length(), foldedText);
+    return QString(reinterpret_cast<const QChar *>(foldedText.constData()), foldedText.size());
+}
+
+void DictionaryRanking::appendFolded(const ushort *text, int length, FoldedText &foldedText)
+{
+    // Lower case without diacritics, special letters are replaced like on keyboards without them: ß -> ss, æ -> ae, ø -> o
+    for (int i = 0; i < length; i++) {
+        ushort character = text[i];
+        if (character < 0x80) {
+            foldedText.append((character >= 'A' && character <= 'Z') ? character + ('a' - 'A') : character);
+            continue;
+        }
+        if (QChar::category(character) == QChar::Mark_NonSpacing) {
+            continue;
+        }
+        character = QChar::toCaseFolded(character);
+        switch (character) {
+        case 0x00DF:
+            foldedText.append('s');
+            foldedText.append('s');
+            break;
+        case 0x00E6:
+            foldedText.append('a');
+            foldedText.append('e');
+            break;
+        case 0x0153:
+            foldedText.append('o');
+            foldedText.append('e');
+            break;
+        case 0x00F8:
+            foldedText.append('o');
+            break;
+        default:
+            foldedText.append(character < BaseCharacterTable::size ? baseCharacterTable.baseCharacters[character] : character);
+        }
+    }
+}
+
+// Same semantics as QString's case insensitive compare(), indexOf() == 0 and contains() on the folded texts
+
+bool DictionaryRanking::isWordMatch(const ushort *word, int wordLength, const ushort *queryString, int queryLength)
+{
+    return wordLength == queryLength && matchesAt(word, 0, queryString, queryLength);
+}
+
+bool DictionaryRanking::isDirectMatch(const ushort *word, int wordLength, const ushort *queryString, int queryLength)
+{
+    return wordLength >= queryLength && matchesAt(word, 0, queryString, queryLength);
+}
+
+bool DictionaryRanking::isIndirectMatch(const ushort *word, int wordLength, const ushort *queryString, int queryLength)
+{
+    for (int position = 0; position + queryLength <= wordLength; position++) {
+        if (matchesAt(word, position, queryString, queryLength)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool DictionaryRanking::matchesAt(const ushort *word, int position, const ushort *queryString, int queryLength)
+{
+    for (int i = 0; i < queryLength; i++) {
+        if (word[position + i] != queryString[i] && QChar::toCaseFolded(word[position + i]) != QChar::toCaseFolded(queryString[i])) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,52 @@
+/*
+    Copyright (C) 2016-19 Sebastian J. Wolf
+
+    This file is part of Wunderfitz.
+
+    Wunderfitz is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    Wunderfitz is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Wunderfitz. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DICTIONARYRANKING_H
+#define DICTIONARYRANKING_H
+
+#include <QSqlDatabase>
+#include <QString>
+#include <QVarLengthArray>
+
+class DictionaryRanking
+{
+public:
+    enum Tier {
+        WordMatch = 0,
+        DirectMatch = 1,
+        IndirectMatch = 2,
+        OtherMatch = 3
+    };
+
+    static int getTier(const QString &leftWord, const QString &rightWord, const QString &foldedQuery);
+    static int getTier(const ushort *leftWord, int leftLength, const ushort *rightWord, int rightLength, const ushort *foldedQuery, int queryLength);
+    static bool registerFunctions(QSqlDatabase &database);
+    static QString fold(const QString &text);
+
+private:
+    typedef QVarLengthArray<ushort, 128> FoldedText;
+
+    static void appendFolded(const ushort *text, int length, FoldedText &foldedText);
+    static bool isWordMatch(const ushort *word, int wordLength, const ushort *queryString, int queryLength);
+    static bool isDirectMatch(const ushort *word, int wordLength, const ushort *queryString, int queryLength);
+    static bool isIndirectMatch(const ushort *word, int wordLength, const ushort *queryString, int queryLength);
+    static bool matchesAt(const ushort *word, int position, const ushort *queryString, int queryLength);
+};
+
+#endif // DICTIONARYRANKING_H
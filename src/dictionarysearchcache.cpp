@@ -0,0 +1,101 @@
+/*
+    Copyright (C) 2016-19 Sebastian J. Wolf
+
+    This file is part of Wunderfitz.
+
+    Wunderfitz is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    Wunderfitz is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Wunderfitz. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "dictionarysearchcache.h"
+#include <QDebug>
+#include <QListIterator>
+#include <QStringList>
+
+DictionarySearchCache::DictionarySearchCache(int maximumSize)
+{
+    this->cachedResults.setMaxCost(maximumSize);
+    this->hits = 0;
+    this->misses = 0;
+}
+
+DictionarySearchCache::~DictionarySearchCache()
+{
+    this->cachedResults.clear();
+}
+
+bool DictionarySearchCache::lookup(const QString &dictionaryId, const QString &queryString, QVector<HeinzelnisseElement> &results)
+{
+    QVector<HeinzelnisseElement>* cachedEntry = this->cachedResults.object(getKey(dictionaryId, queryString));
+    if (cachedEntry == 0) {
+        this->misses++;
+        return false;
+    }
+    this->hits++;
+    // Implicitly shared, the elements aren't copied
+    results = *cachedEntry;
+    qDebug() << "Search cache hit for " + queryString + ", hits: " + QString::number(this->hits) + ", misses: " + QString::number(this->misses);
+    return true;
+}
+
+void DictionarySearchCache::insert(const QString &dictionaryId, const QString &queryString, const QVector<HeinzelnisseElement> &results)
+{
+    // QCache takes ownership, entries which exceed the whole budget are deleted right away
+    this->cachedResults.insert(getKey(dictionaryId, queryString), new QVector<HeinzelnisseElement>(results), getCost(results));
+}
+
+void DictionarySearchCache::invalidate(const QString &dictionaryId)
+{
+    QString keyPrefix = dictionaryId + "\n";
+    QStringList cachedKeys = this->cachedResults.keys();
+    QListIterator<QString> keyIterator(cachedKeys);
+    while (keyIterator.hasNext()) {
+        QString nextKey = keyIterator.next();
+        if (nextKey.startsWith(keyPrefix)) {
+            this->cachedResults.remove(nextKey);
+        }
+    }
+}
+
+int DictionarySearchCache::getHits() const
+{
+    return this->hits;
+}
+
+int DictionarySearchCache::getMisses() const
+{
+    return this->misses;
+}
+
+QString DictionarySearchCache::getKey(const QString &dictionaryId, const QString &queryString)
+{
+    // Matching and ranking are case-insensitive, so "Haus" and "haus" share their results.
+    // Otherwise the query is kept as it's passed to SQLite, whitespace may be significant for FTS queries.
+    return dictionaryId + "\n" + queryString.toCaseFolded();
+}
+
+int DictionarySearchCache::getCost(const QVector<HeinzelnisseElement> &results)
+{
+    // Approximate size in bytes, the budget doesn't need to be exact
+    int cost = sizeof(QVector<HeinzelnisseElement>) + results.size() * sizeof(HeinzelnisseElement);
+    for (int i = 0; i < results.size(); i++) {
+        const HeinzelnisseElement &nextElement = results.at(i);
+        int textLength = nextElement.getWordLeft().length() + nextElement.getGenderLeft().length()
+                + nextElement.getOptionalLeft().length() + nextElement.getOtherLeft().length()
+                + nextElement.getWordRight().length() + nextElement.getGenderRight().length()
+                + nextElement.getOptionalRight().length() + nextElement.getOtherRight().length()
+                + nextElement.getCategory().length() + nextElement.getGrade().length();
+        cost += textLength * sizeof(QChar);
+    }
+    return cost;
+}
@@ -0,0 +1,50 @@
+/*
+    Copyright (C) 2016-19 Sebastian J. Wolf
+
+    This file is part of Wunderfitz.
+
+    Wunderfitz is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    Wunderfitz is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Wunderfitz. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DICTIONARYSEARCHCACHE_H
+#define DICTIONARYSEARCHCACHE_H
+
+#include <QCache>
+#include <QString>
+#include <QVector>
+#include "heinzelnisseelement.h"
+
+class DictionarySearchCache
+{
+public:
+    DictionarySearchCache(int maximumSize);
+    ~DictionarySearchCache();
+
+    bool lookup(const QString &dictionaryId, const QString &queryString, QVector<HeinzelnisseElement> &results);
+    void insert(const QString &dictionaryId, const QString &queryString, const QVector<HeinzelnisseElement> &results);
+    void invalidate(const QString &dictionaryId);
+
+    int getHits() const;
+    int getMisses() const;
+
+private:
+    QCache<QString, QVector<HeinzelnisseElement> > cachedResults;
+    int hits;
+    int misses;
+
+    static QString getKey(const QString &dictionaryId, const QString &queryString);
+    static int getCost(const QVector<HeinzelnisseElement> &results);
+};
+
+#endif // DICTIONARYSEARCHCACHE_H
@@ -18,142 +18,429 @@
 */
 
 #include "dictionarysearchworker.h"
+#include "dictionaryconnectionpool.h"
+#include "dictionaryfuzzyindex.h"
+#include "dictionaryinfixindex.h"
 #include "dictionarymodel.h"
+#include "dictionaryranking.h"
+#include <algorithm>
+#include <QDebug>
+#include <QSqlDriver>
+#include <QSqlError>
+#include <QSqlRecord>
+#include <sqlite3.h>
 
-DictionarySearchWorker::DictionarySearchWorker(QList<HeinzelnisseElement*>* resultList)
+const int DictionarySearchWorker::pageSize = 50;
+
+DictionarySearchWorker::DictionarySearchWorker()
 {
-    this->resultList = resultList;
+    this->searchId = 0;
+    this->previousResultsComplete = false;
+    this->moreResultsAvailable = false;
+    this->fetchMore = false;
+    this->fuzzyResults = false;
+    this->infixResults = false;
+    this->foldedSearch = false;
+    this->fts5Search = false;
+    this->interrupted = false;
 }
 
-void DictionarySearchWorker::setQueryParameters(QSqlDatabase &database, QString &dictionaryId, const QString &queryString)
+void DictionarySearchWorker::setQueryParameters(int searchId, const QString &dictionaryId, const QString &queryString)
 {
-    this->database = database;
+    this->searchId = searchId;
     this->queryString = queryString;
     this->dictionaryId = dictionaryId;
+    this->fetchMore = false;
+}
+
+void DictionarySearchWorker::setFetchMoreParameters(int searchId)
+{
+    // Continues the last search with the next page
+    this->searchId = searchId;
+    this->fetchMore = true;
+}
+
+bool DictionarySearchWorker::hasMoreResults() const
+{
+    return this->moreResultsAvailable;
+}
+
+void DictionarySearchWorker::resetPreviousResults()
+{
+    this->previousQueryString.clear();
+    this->previousDictionaryId.clear();
+    this->previousResultsComplete = false;
+    this->moreResultsAvailable = false;
+}
+
+void DictionarySearchWorker::setPreviousResults(const QString &dictionaryId, const QString &queryString, const QVector<HeinzelnisseElement> &results)
+{
+    // Results taken from the cache were plain prefix searches which weren't interrupted, they're continued and refined like our own ones.
+    // Only the last page of a search can be smaller than the page size.
+    this->results = results;
+    this->dictionaryId = dictionaryId;
+    this->queryString = queryString;
+    // Depends on the schema of the dictionary, it's set up when the search is continued
+    this->matchExpression.clear();
+    this->rankQueryString = DictionaryRanking::fold(queryString);
+    this->fuzzyResults = false;
+    this->infixResults = false;
+    this->previousQueryString = queryString;
+    this->previousDictionaryId = dictionaryId;
+    this->moreResultsAvailable = !results.isEmpty() && results.size() % pageSize == 0;
+    this->previousResultsComplete = !this->moreResultsAvailable;
 }
 
 void DictionarySearchWorker::performSearch()
 {
-    qDeleteAll(*resultList);
-    resultList->clear();
+    this->interrupted = false;
 
-    if (database.open()) {
-        QSqlQuery query(database);
+    // The worker uses its own read-only connection, GUI thread connections can't be shared
+    DictionaryConnectionPool::releaseStaleConnections();
+    database = DictionaryConnectionPool::getConnection(dictionaryId);
+    QStringList tableNames = database.isOpen() ? database.tables() : QStringList();
+    foldedSearch = tableNames.contains("folded");
+    fts5Search = tableNames.contains("dictionary_search");
 
-        if (this->dictionaryId == DictionaryModel::heinzelnisseId) {
-            query.prepare("select * from heinzelnisse where heinzelnisse match (:queryString)");
-        } else {
-            query.prepare("select * from entries where entries match (:queryString)");
-        }
+    if (!fetchMore && canRefinePreviousResults()) {
+        refinePreviousResults();
+        this->previousQueryString = queryString;
+        emit searchCompleted(searchId, dictionaryId, queryString, results, isPlainQuery(queryString));
+        return;
+    }
+
+    if (!fetchMore) {
+        results.clear();
+        matchExpression.clear();
+        // Folded once for all rows, wf_rank() only folds the headwords
+        rankQueryString = DictionaryRanking::fold(queryString);
+        fuzzyResults = false;
+        infixResults = false;
+    }
+    if (matchExpression.isEmpty()) {
+        matchExpression = getPrefixExpression(queryString);
+    }
+    results.reserve(results.size() + pageSize);
+    int addedResults = 0;
 
-        query.bindValue(":queryString", queryString + "*");
-        addQueryResults(query, queryString);
+    if (database.isOpen()) {
+        QString tableName = (this->dictionaryId == DictionaryModel::heinzelnisseId) ? "heinzelnisse" : (fts5Search ? "dictionary_entries" : "entries");
+        setProgressHandler(true);
+        if (!fetchMore) {
+            addInfixWords();
+        }
+        addedResults = addRankedResults(tableName);
+        if (!fetchMore && addedResults == 0 && !isInterruptionRequested() && addFuzzyResults(tableName)) {
+            addedResults = results.size();
+        }
+        setProgressHandler(false);
     } else {
         qDebug() << "Unable to perform a query on database";
     }
 
-    emit searchCompleted(queryString);
+    // Only a result list which wasn't cut off by the page size or an interruption can be refined later on
+    this->previousQueryString = queryString;
+    this->previousDictionaryId = dictionaryId;
+    this->interrupted = isInterruptionRequested();
+    this->moreResultsAvailable = this->interrupted || addedResults == pageSize;
+    this->previousResultsComplete = !this->moreResultsAvailable && !this->fuzzyResults && !this->infixResults;
+
+    // Fuzzy and infix results can't be restored from the cache by a prefix search, just like queries with FTS syntax
+    bool cacheable = !this->interrupted && !this->fuzzyResults && !this->infixResults && isPlainQuery(queryString);
+
+    // The results are passed by value, the GUI thread never reads them while the worker may already change them again
+    emit searchCompleted(searchId, dictionaryId, queryString, results, cacheable);
+}
+
+int DictionarySearchWorker::addRankedResults(const QString &tableName)
+{
+    // Results are ranked and paged by SQLite, each page continues after the tier and rowid of the last result
+    QString pageCondition;
+    if (!results.isEmpty()) {
+        pageCondition = " where wf_tier > (:lastTier) or (wf_tier = (:sameTier) and wf_rowid > (:lastRowId))";
+    }
+    // Entries with diacritics or special letters are also looked up in the folded index, which costs one more FTS query.
+    // The query is folded as well, so "Strasse" also finds "Straße" and "hauser" finds "Häuser".
+    QString foldedMatchExpression = (foldedSearch && !fuzzyResults && isPlainQuery(queryString)) ? DictionaryRanking::fold(queryString) + "*" : QString();
+    // Rows found by both get the same tier, so the union keeps only one of them.
+    QString rankedRows = "select *, rowid as wf_rowid, " + getRankingExpression(tableName, ":rankQuery") + " as wf_tier from " + tableName + " where " + getMatchCondition(tableName);
+    if (!foldedMatchExpression.isEmpty()) {
+        rankedRows += " union select *, rowid as wf_rowid, " + getRankingExpression(tableName, ":foldedRankQuery") + " as wf_tier from " + tableName
+                + " where rowid in (select docid from folded where folded match (:foldedQueryString))";
+    }
+    QSqlQuery query(database);
+    query.setForwardOnly(true);
+    query.prepare("select * from (" + rankedRows + ")" + pageCondition + " order by wf_tier, wf_rowid limit " + QString::number(pageSize));
+    query.bindValue(":queryString", matchExpression);
+    query.bindValue(":rankQuery", rankQueryString);
+    if (!foldedMatchExpression.isEmpty()) {
+        query.bindValue(":foldedQueryString", foldedMatchExpression);
+        query.bindValue(":foldedRankQuery", rankQueryString);
+    }
+    if (!results.isEmpty()) {
+        const HeinzelnisseElement &lastElement = results.last();
+        int lastTier = DictionaryRanking::getTier(lastElement.getWordLeft(), lastElement.getWordRight(), rankQueryString);
+        query.bindValue(":lastTier", lastTier);
+        query.bindValue(":sameTier", lastTier);
+        query.bindValue(":lastRowId", lastElement.getRowId());
+    }
+    return addQueryResults(query);
+}
+
+bool DictionarySearchWorker::addFuzzyResults(const QString &tableName)
+{
+    // Nothing found, maybe the query contains a typo. The closest words of the vocabulary are searched instead.
+    if (!isPlainQuery(queryString) || !DictionaryFuzzyIndex::isAvailable(database)) {
+        return false;
+    }
+    QStringList candidates = DictionaryFuzzyIndex::findCandidates(database, queryString, 5);
+    if (candidates.isEmpty()) {
+        return false;
+    }
+    matchExpression = getWordsExpression(candidates);
+    rankQueryString = DictionaryRanking::fold(candidates.first());
+    fuzzyResults = true;
+    return addRankedResults(tableName) > 0;
 }
 
-bool DictionarySearchWorker::isWordMatch(HeinzelnisseElement *&heinzelnisseElement, const QString &queryString)
+void DictionarySearchWorker::addInfixWords()
 {
-    if (QString::compare(heinzelnisseElement->getWordLeft(), queryString, Qt::CaseInsensitive) == 0 ||
-            QString::compare(heinzelnisseElement->getWordRight(), queryString, Qt::CaseInsensitive) == 0) {
-        return true;
+    // Compound words containing the query are added to the prefix query, e.g. "haustür" for "tür"
+    if (!isPlainQuery(queryString) || !DictionaryInfixIndex::isAvailable(database)) {
+        return;
+    }
+    QStringList infixWords = DictionaryInfixIndex::findWords(database, queryString);
+    if (!infixWords.isEmpty()) {
+        matchExpression = getPrefixExpression(queryString) + " OR " + getWordsExpression(infixWords);
+        infixResults = true;
     }
-    return false;
 }
 
-bool DictionarySearchWorker::isDirectMatch(HeinzelnisseElement *&heinzelnisseElement, const QString &queryString)
+bool DictionarySearchWorker::canRefinePreviousResults() const
 {
-    if (heinzelnisseElement->getWordLeft().indexOf(queryString, 0, Qt::CaseInsensitive) == 0 ||
-            heinzelnisseElement->getWordRight().indexOf(queryString, 0, Qt::CaseInsensitive) == 0) {
-        return true;
+    // Each row matching "hause*" also matches "haus*", so a complete result list for "haus" contains all results for "hause"
+    return this->previousResultsComplete
+            && this->previousDictionaryId == this->dictionaryId
+            && !this->previousQueryString.isEmpty()
+            && this->queryString.length() > this->previousQueryString.length()
+            && this->queryString.startsWith(this->previousQueryString, Qt::CaseInsensitive)
+            && isPlainQuery(this->queryString);
+}
+
+void DictionarySearchWorker::refinePreviousResults()
+{
+    QString foldedQuery = queryString.toCaseFolded();
+    QString diacriticFreeQuery = foldedSearch ? DictionaryRanking::fold(queryString) : QString();
+    QString rankQuery = DictionaryRanking::fold(queryString);
+    QVector<HeinzelnisseElement> rankedResults[4];
+    for (int i = 0; i < results.size(); i++) {
+        const HeinzelnisseElement &nextElement = results.at(i);
+        if (matchesQuery(nextElement, foldedQuery, diacriticFreeQuery, fts5Search)) {
+            rankedResults[DictionaryRanking::getTier(nextElement.getWordLeft(), nextElement.getWordRight(), rankQuery)].append(nextElement);
+        }
     }
-    return false;
+
+    // Same order as wf_rank() and rowid in SQLite
+    results.clear();
+    for (int i = 0; i < 4; i++) {
+        std::stable_sort(rankedResults[i].begin(), rankedResults[i].end(), isLowerRowId);
+        results += rankedResults[i];
+    }
+}
+
+bool DictionarySearchWorker::isPlainQuery(const QString &queryString)
+{
+    // Anything else may be FTS query syntax, such queries are always passed to SQLite
+    for (int i = 0; i < queryString.length(); i++) {
+        if (!queryString.at(i).isLetterOrNumber()) {
+            return false;
+        }
+    }
+    return true;
 }
 
-bool DictionarySearchWorker::isIndirectMatch(HeinzelnisseElement *&heinzelnisseElement, const QString &queryString)
+bool DictionarySearchWorker::matchesQuery(const HeinzelnisseElement &element, const QString &foldedQuery, const QString &diacriticFreeQuery, bool headwordsOnly)
 {
-    if (heinzelnisseElement->getWordLeft().contains(queryString, Qt::CaseInsensitive) ||
-            heinzelnisseElement->getWordRight().contains(queryString, Qt::CaseInsensitive)) {
+    // The folded index only contains the headwords
+    if (!diacriticFreeQuery.isEmpty()
+            && (containsTokenPrefix(DictionaryRanking::fold(element.getWordLeft()), diacriticFreeQuery)
+                || containsTokenPrefix(DictionaryRanking::fold(element.getWordRight()), diacriticFreeQuery))) {
         return true;
     }
+    // The FTS5 index only contains the headwords as well
+    if (headwordsOnly) {
+        return containsTokenPrefix(element.getWordLeft(), foldedQuery)
+                || containsTokenPrefix(element.getWordRight(), foldedQuery);
+    }
+    // All columns of the FTS4 tables are indexed, so all of them need to be checked
+    return containsTokenPrefix(QString::number(element.getIndex()), foldedQuery)
+            || containsTokenPrefix(element.getWordLeft(), foldedQuery)
+            || containsTokenPrefix(element.getGenderLeft(), foldedQuery)
+            || containsTokenPrefix(element.getOptionalLeft(), foldedQuery)
+            || containsTokenPrefix(element.getOtherLeft(), foldedQuery)
+            || containsTokenPrefix(element.getWordRight(), foldedQuery)
+            || containsTokenPrefix(element.getGenderRight(), foldedQuery)
+            || containsTokenPrefix(element.getOptionalRight(), foldedQuery)
+            || containsTokenPrefix(element.getOtherRight(), foldedQuery)
+            || containsTokenPrefix(element.getCategory(), foldedQuery)
+            || containsTokenPrefix(element.getGrade(), foldedQuery);
+}
+
+bool DictionarySearchWorker::containsTokenPrefix(const QString &text, const QString &foldedQuery)
+{
+    // Tokens are split like the unicode61 tokenizer does it: letters, numbers and marks belong to a token
+    QString foldedText = text.toCaseFolded();
+    bool previousIsTokenCharacter = false;
+    for (int i = 0; i < foldedText.length(); i++) {
+        QChar currentCharacter = foldedText.at(i);
+        bool isTokenCharacter = currentCharacter.isLetterOrNumber() || currentCharacter.isMark();
+        if (isTokenCharacter && !previousIsTokenCharacter && foldedText.midRef(i, foldedQuery.length()) == foldedQuery) {
+            return true;
+        }
+        previousIsTokenCharacter = isTokenCharacter;
+    }
     return false;
 }
 
-void DictionarySearchWorker::appendRawList(QList<HeinzelnisseElement *> &rawList)
+bool DictionarySearchWorker::isLowerRowId(const HeinzelnisseElement &firstElement, const HeinzelnisseElement &secondElement)
+{
+    return firstElement.getRowId() < secondElement.getRowId();
+}
+
+QString DictionarySearchWorker::getRankingExpression(const QString &tableName, const QString &placeholder)
+{
+    // wf_rank() is registered by the DictionaryConnectionPool, see DictionaryRanking for the tiers.
+    // The word columns are taken from the table definition, as both dictionary types use different layouts.
+    QSqlRecord tableRecord = database.record(tableName);
+    QString leftWordColumn;
+    QString rightWordColumn;
+    if (this->dictionaryId == DictionaryModel::heinzelnisseId) {
+        leftWordColumn = tableRecord.fieldName(5);
+        rightWordColumn = tableRecord.fieldName(1);
+    } else {
+        leftWordColumn = tableRecord.fieldName(1);
+        rightWordColumn = tableRecord.fieldName(4);
+    }
+    return "wf_rank(" + leftWordColumn + ", " + rightWordColumn + ", (" + placeholder + "))";
+}
+
+QString DictionarySearchWorker::getMatchCondition(const QString &tableName) const
+{
+    // The FTS5 index is separate from the table with the content, it only returns the matching rowids
+    if (fts5Search) {
+        return "rowid in (select rowid from dictionary_search where dictionary_search match (:queryString))";
+    }
+    return tableName + " match (:queryString)";
+}
+
+QString DictionarySearchWorker::getPrefixExpression(const QString &queryString) const
+{
+    if (!fts5Search) {
+        return queryString + "*";
+    }
+    // FTS5 rejects many characters outside of quotes, so each token of the query is quoted and they're combined with AND.
+    // Tokens are split like in containsTokenPrefix(), a quoted string with several tokens would be a phrase query,
+    // which isn't supported with detail=column. FTS4 query syntax is therefore not available for FTS5 dictionaries.
+    QStringList tokens;
+    QString currentToken;
+    for (int i = 0; i <= queryString.length(); i++) {
+        if (i < queryString.length() && (queryString.at(i).isLetterOrNumber() || queryString.at(i).isMark())) {
+            currentToken.append(queryString.at(i));
+        } else if (!currentToken.isEmpty()) {
+            tokens.append("\"" + currentToken + "\"");
+            currentToken.clear();
+        }
+    }
+    if (tokens.isEmpty()) {
+        return "\"\"";
+    }
+    return tokens.join(" ") + "*";
+}
+
+QString DictionarySearchWorker::getWordsExpression(const QStringList &words) const
 {
-    QListIterator<HeinzelnisseElement*> listIterator(rawList);
-    while (listIterator.hasNext() && resultList->size() <= 200) {
-        resultList->append(listIterator.next());
+    // Fuzzy and infix candidates are words of the dictionary, any of them may match
+    if (!fts5Search) {
+        return words.join(" OR ");
     }
+    QStringList quotedWords;
+    for (int i = 0; i < words.size(); i++) {
+        quotedWords.append("\"" + QString(words.at(i)).replace("\"", "\"\"") + "\"");
+    }
+    return quotedWords.join(" OR ");
 }
 
-void DictionarySearchWorker::populateElementFromQuery(const QSqlQuery &query, HeinzelnisseElement* &heinzelnisseElement) const {
+void DictionarySearchWorker::populateElementFromQuery(const QSqlQuery &query, int rowIdColumn, HeinzelnisseElement &heinzelnisseElement) const {
+    heinzelnisseElement.setRowId(query.value(rowIdColumn).toLongLong());
     if (this->dictionaryId == DictionaryModel::heinzelnisseId) {
-        heinzelnisseElement->setIndex(query.value(0).toInt());
-        heinzelnisseElement->setWordLeft(query.value(5).toString());
-        heinzelnisseElement->setGenderLeft(query.value(6).toString());
-        heinzelnisseElement->setOptionalLeft(query.value(7).toString());
-        heinzelnisseElement->setOtherLeft(query.value(8).toString());
-        heinzelnisseElement->setWordRight(query.value(1).toString());
-        heinzelnisseElement->setGenderRight(query.value(2).toString());
-        heinzelnisseElement->setOptionalRight(query.value(3).toString());
-        heinzelnisseElement->setOtherRight(query.value(4).toString());
-        heinzelnisseElement->setCategory(query.value(9).toString());
-        heinzelnisseElement->setGrade(query.value(10).toString());
+        heinzelnisseElement.setIndex(query.value(0).toInt());
+        heinzelnisseElement.setWordLeft(query.value(5).toString());
+        heinzelnisseElement.setGenderLeft(query.value(6).toString());
+        heinzelnisseElement.setOptionalLeft(query.value(7).toString());
+        heinzelnisseElement.setOtherLeft(query.value(8).toString());
+        heinzelnisseElement.setWordRight(query.value(1).toString());
+        heinzelnisseElement.setGenderRight(query.value(2).toString());
+        heinzelnisseElement.setOptionalRight(query.value(3).toString());
+        heinzelnisseElement.setOtherRight(query.value(4).toString());
+        heinzelnisseElement.setCategory(query.value(9).toString());
+        heinzelnisseElement.setGrade(query.value(10).toString());
     } else {
-        heinzelnisseElement->setIndex(query.value(0).toInt());
-        heinzelnisseElement->setWordLeft(query.value(1).toString());
-        heinzelnisseElement->setGenderLeft(query.value(2).toString());
-        heinzelnisseElement->setOptionalLeft("");
-        heinzelnisseElement->setOtherLeft(query.value(3).toString());
-        heinzelnisseElement->setWordRight(query.value(4).toString());
-        heinzelnisseElement->setGenderRight(query.value(5).toString());
-        heinzelnisseElement->setOptionalRight("");
-        heinzelnisseElement->setOtherRight(query.value(6).toString());
-        heinzelnisseElement->setCategory(query.value(7).toString());
-        heinzelnisseElement->setGrade("");
-    }
-    QString clipboardText = heinzelnisseElement->getWordLeft() + " "
-                            + heinzelnisseElement->getGenderLeft() + " "
-                            + heinzelnisseElement->getOtherLeft() + " - "
-                            + heinzelnisseElement->getWordRight() + " "
-                            + heinzelnisseElement->getGenderRight() + " "
-                            + heinzelnisseElement->getOtherRight();
-    heinzelnisseElement->setClipboardText(clipboardText.simplified());
-
-}
-
-void DictionarySearchWorker::addQueryResults(QSqlQuery &query, const QString &queryString) {
-    query.exec();
-    QList<HeinzelnisseElement*> wordMatches;
-    QList<HeinzelnisseElement*> directMatches;
-    QList<HeinzelnisseElement*> indirectMatches;
-    QList<HeinzelnisseElement*> otherMatches;
+        heinzelnisseElement.setIndex(query.value(0).toInt());
+        heinzelnisseElement.setWordLeft(query.value(1).toString());
+        heinzelnisseElement.setGenderLeft(query.value(2).toString());
+        heinzelnisseElement.setOptionalLeft(QString());
+        heinzelnisseElement.setOtherLeft(query.value(3).toString());
+        heinzelnisseElement.setWordRight(query.value(4).toString());
+        heinzelnisseElement.setGenderRight(query.value(5).toString());
+        heinzelnisseElement.setOptionalRight(QString());
+        heinzelnisseElement.setOtherRight(query.value(6).toString());
+        heinzelnisseElement.setCategory(query.value(7).toString());
+        heinzelnisseElement.setGrade(QString());
+    }
+}
+
+int DictionarySearchWorker::addQueryResults(QSqlQuery &query) {
+    int addedResults = 0;
+    if (!query.exec()) {
+        if (isInterruptionRequested()) {
+            qDebug() << "Search for " + queryString + " was cancelled";
+        } else {
+            qDebug() << "Unable to perform a query on database - " + query.lastError().text();
+        }
+        return addedResults;
+    }
+    int rowIdColumn = query.record().indexOf("wf_rowid");
     while (query.next()) {
         if (isInterruptionRequested()) {
             break;
         }
-        HeinzelnisseElement* nextElement = new HeinzelnisseElement();
-        populateElementFromQuery(query, nextElement);
-        if (isWordMatch(nextElement, queryString)) {
-            wordMatches.append(nextElement);
-            continue;
-        }
-        if (isDirectMatch(nextElement, queryString)) {
-            directMatches.append(nextElement);
-            continue;
-        }
-        if (isIndirectMatch(nextElement, queryString)) {
-            indirectMatches.append(nextElement);
-            continue;
-        }
-        otherMatches.append(nextElement);
+        results.append(HeinzelnisseElement());
+        populateElementFromQuery(query, rowIdColumn, results.last());
+        addedResults++;
+    }
+    return addedResults;
+}
+
+void DictionarySearchWorker::setProgressHandler(bool enabled)
+{
+    // SQLite calls the handler while it executes the statement, so a long FTS step can be cancelled as well
+    QVariant driverHandle = database.driver()->handle();
+    if (!driverHandle.isValid() || qstrcmp(driverHandle.typeName(), "sqlite3*") != 0) {
+        return;
     }
-    appendRawList(wordMatches);
-    appendRawList(directMatches);
-    appendRawList(indirectMatches);
-    appendRawList(otherMatches);
+    sqlite3 *sqliteHandle = *static_cast<sqlite3 **>(driverHandle.data());
+    if (sqliteHandle == 0) {
+        return;
+    }
+    if (enabled) {
+        sqlite3_progress_handler(sqliteHandle, 1000, &handleProgress, this);
+    } else {
+        sqlite3_progress_handler(sqliteHandle, 0, 0, 0);
+    }
+}
+
+int DictionarySearchWorker::handleProgress(void *searchWorker)
+{
+    // A non-zero return value aborts the running statement with SQLITE_INTERRUPT
+    return static_cast<DictionarySearchWorker*>(searchWorker)->isInterruptionRequested() ? 1 : 0;
 }
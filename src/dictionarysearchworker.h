@@ -20,10 +20,11 @@
 #ifndef DICTIONARYSEARCHWORKER_H
 #define DICTIONARYSEARCHWORKER_H
 
-#include <QList>
+#include <QVector>
 #include <QSqlDatabase>
 #include <QSqlQuery>
 #include <QString>
+#include <QStringList>
 #include <QThread>
 #include "heinzelnisseelement.h"
 
@@ -35,23 +36,53 @@ class DictionarySearchWorker : public QThread
     }
 
 public:
-    DictionarySearchWorker(QList<HeinzelnisseElement*>* resultList);
-    void setQueryParameters(QSqlDatabase &database, QString &dictionaryId, const QString &queryString);
+    static const int pageSize;
+
+    DictionarySearchWorker();
+    void setQueryParameters(int searchId, const QString &dictionaryId, const QString &queryString);
+    void setFetchMoreParameters(int searchId);
+    bool hasMoreResults() const;
+    void resetPreviousResults();
+    void setPreviousResults(const QString &dictionaryId, const QString &queryString, const QVector<HeinzelnisseElement> &results);
 signals:
-    void searchCompleted(const QString &queryString);
+    void searchCompleted(int searchId, const QString &dictionaryId, const QString &queryString, const QVector<HeinzelnisseElement> &results, bool cacheable);
 private:
     QSqlDatabase database;
+    int searchId;
     QString dictionaryId;
-    QList<HeinzelnisseElement*>* resultList;
+    QVector<HeinzelnisseElement> results;
     QString queryString;
+    QString matchExpression;
+    bool foldedSearch;
+    bool fts5Search;
+    QString rankQueryString;
+    bool fuzzyResults;
+    bool infixResults;
+    QString previousQueryString;
+    QString previousDictionaryId;
+    bool previousResultsComplete;
+    bool moreResultsAvailable;
+    bool fetchMore;
+    bool interrupted;
 
     void performSearch();
-    void populateElementFromQuery(const QSqlQuery &query, HeinzelnisseElement* &heinzelnisseElement) const;
-    void addQueryResults(QSqlQuery &query, const QString &queryString);
-    bool isWordMatch(HeinzelnisseElement* &heinzelnisseElement, const QString &queryString);
-    bool isDirectMatch(HeinzelnisseElement* &heinzelnisseElement, const QString &queryString);
-    bool isIndirectMatch(HeinzelnisseElement* &heinzelnisseElement, const QString &queryString);
-    void appendRawList(QList<HeinzelnisseElement*> &rawList);
+    bool canRefinePreviousResults() const;
+    void refinePreviousResults();
+    static bool isPlainQuery(const QString &queryString);
+    static bool matchesQuery(const HeinzelnisseElement &element, const QString &foldedQuery, const QString &diacriticFreeQuery, bool headwordsOnly);
+    static bool containsTokenPrefix(const QString &text, const QString &foldedQuery);
+    static bool isLowerRowId(const HeinzelnisseElement &firstElement, const HeinzelnisseElement &secondElement);
+    void populateElementFromQuery(const QSqlQuery &query, int rowIdColumn, HeinzelnisseElement &heinzelnisseElement) const;
+    QString getRankingExpression(const QString &tableName, const QString &placeholder);
+    QString getMatchCondition(const QString &tableName) const;
+    QString getPrefixExpression(const QString &queryString) const;
+    QString getWordsExpression(const QStringList &words) const;
+    int addQueryResults(QSqlQuery &query);
+    int addRankedResults(const QString &tableName);
+    bool addFuzzyResults(const QString &tableName);
+    void addInfixWords();
+    void setProgressHandler(bool enabled);
+    static int handleProgress(void *searchWorker);
 };
 
 #endif // DICTIONARYSEARCHWORKER_H
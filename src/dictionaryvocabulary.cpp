@@ -0,0 +1,61 @@
+/*
+    Copyright (C) 2016-19 Sebastian J. Wolf
+
+    This file is part of Wunderfitz.
+
+    Wunderfitz is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    Wunderfitz is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Wunderfitz. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "dictionaryvocabulary.h"
+#include "dictionaryfuzzyindex.h"
+#include <QDebug>
+#include <QSqlError>
+#include <QSqlQuery>
+
+bool DictionaryVocabulary::build(QSqlDatabase &database, const QString &tableName, const QStringList &wordColumns)
+{
+    QSqlQuery databaseQuery(database);
+    databaseQuery.exec("drop table if exists temp.vocabulary");
+    if (!databaseQuery.exec("create temp table vocabulary(word text primary key) without rowid")) {
+        qDebug() << "Error creating vocabulary table - " + databaseQuery.lastError().text();
+        return false;
+    }
+
+    // The primary key removes duplicates while the entries are streamed
+    QSqlQuery wordsQuery(database);
+    wordsQuery.setForwardOnly(true);
+    if (!wordsQuery.exec("select " + wordColumns.join(", ") + " from " + tableName)) {
+        qDebug() << "Error reading the vocabulary - " + wordsQuery.lastError().text();
+        return false;
+    }
+    databaseQuery.prepare("insert or ignore into vocabulary values (?)");
+    while (wordsQuery.next()) {
+        for (int i = 0; i < wordColumns.size(); i++) {
+            QStringList words = DictionaryFuzzyIndex::getWords(wordsQuery.value(i).toString());
+            for (int j = 0; j < words.size(); j++) {
+                databaseQuery.addBindValue(words.at(j));
+                if (!databaseQuery.exec()) {
+                    qDebug() << databaseQuery.lastError().text();
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void DictionaryVocabulary::drop(QSqlDatabase &database)
+{
+    QSqlQuery databaseQuery(database);
+    databaseQuery.exec("drop table if exists temp.vocabulary");
+}
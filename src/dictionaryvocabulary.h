@@ -0,0 +1,36 @@
+/*
+    Copyright (C) 2016-19 Sebastian J. Wolf
+
+    This file is part of Wunderfitz.
+
+    Wunderfitz is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    Wunderfitz is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Wunderfitz. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DICTIONARYVOCABULARY_H
+#define DICTIONARYVOCABULARY_H
+
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+
+// Distinct words of the headwords, collected once for the fuzzy and infix indexes.
+// They're kept in a temporary table, so memory usage doesn't grow with the size of the dictionary.
+class DictionaryVocabulary
+{
+public:
+    static bool build(QSqlDatabase &database, const QString &tableName, const QStringList &wordColumns);
+    static void drop(QSqlDatabase &database);
+};
+
+#endif // DICTIONARYVOCABULARY_H
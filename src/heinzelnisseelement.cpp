@@ -19,8 +19,9 @@
 
 #include "heinzelnisseelement.h"
 
-HeinzelnisseElement::HeinzelnisseElement(QObject* parent) : QObject(parent) {
-
+HeinzelnisseElement::HeinzelnisseElement() {
+    index = 0;
+    rowId = 0;
 }
 
 QString HeinzelnisseElement::getWordLeft() const
@@ -133,13 +134,21 @@ void HeinzelnisseElement::setIndex(int value)
     index = value;
 }
 
-QString HeinzelnisseElement::getClipboardText() const
+qint64 HeinzelnisseElement::getRowId() const
+{
+    return rowId;
+}
+
+void HeinzelnisseElement::setRowId(qint64 value)
 {
-    return clipboardText;
+    rowId = value;
 }
 
-void HeinzelnisseElement::setClipboardText(const QString &value)
+QString HeinzelnisseElement::getClipboardText() const
 {
-    clipboardText = value;
+    // Only needed when the user copies a result, so it isn't stored
+    QString clipboardText = wordLeft + " " + genderLeft + " " + otherLeft + " - "
+                            + wordRight + " " + genderRight + " " + otherRight;
+    return clipboardText.simplified();
 }
 
@@ -21,15 +21,12 @@
 #define HEINZELNISSEELEMENT_H
 
 #include <QString>
-#include <QDebug>
-#include <QObject>
 
-class HeinzelnisseElement : public QObject {
-
-    Q_OBJECT
+// Plain value type, search results are stored in implicitly shared QVectors without any per-result allocation
+class HeinzelnisseElement {
 
 public:
-    HeinzelnisseElement(QObject* parent = 0);
+    HeinzelnisseElement();
     QString getWordLeft() const;
     void setWordLeft(const QString &value);
 
@@ -63,15 +60,18 @@ public:
     int getIndex() const;
     void setIndex(int value);
 
+    qint64 getRowId() const;
+    void setRowId(qint64 value);
+
     inline bool operator ==(const HeinzelnisseElement &otherHeinzelnisseElement) const {
         return (index == otherHeinzelnisseElement.getIndex());
     }
 
     QString getClipboardText() const;
-    void setClipboardText(const QString &value);
 
 private:
     int index;
+    qint64 rowId;
     QString wordLeft;
     QString genderLeft;
     QString optionalLeft;
@@ -82,8 +82,9 @@ private:
     QString otherRight;
     QString category;
     QString grade;
-    QString clipboardText;
 
 };
 
+Q_DECLARE_TYPEINFO(HeinzelnisseElement, Q_MOVABLE_TYPE);
+
 #endif // HEINZELNISSEELEMENT_H
@@ -18,15 +18,16 @@
 */
 
 #include <QDebug>
+#include <QSet>
 #include "heinzelnissemodel.h"
 
 HeinzelnisseModel::HeinzelnisseModel(QObject *parent) : QAbstractListModel(parent)
 {
     databaseManager = new DatabaseManager(this);
+    resetPending = false;
     // Initializations (and Test Code ;))
     if (databaseManager->isOpen()) {
         qDebug() << "Database successfully initialized!";
-        resultList = databaseManager->getResultList();
     } else {
         qDebug() << "Unable to initialize database!";
     }
@@ -35,33 +36,78 @@ HeinzelnisseModel::HeinzelnisseModel(QObject *parent) : QAbstractListModel(paren
 
     connect(databaseManager, SIGNAL(searchCompleted(QString)), this, SLOT(handleSearchCompleted(QString)));
 
+    roles.insert(WordLeftRole, "wordLeft");
+    roles.insert(GenderLeftRole, "genderLeft");
+    roles.insert(OptionalLeftRole, "optionalLeft");
+    roles.insert(OtherLeftRole, "otherLeft");
+    roles.insert(WordRightRole, "wordRight");
+    roles.insert(GenderRightRole, "genderRight");
+    roles.insert(OptionalRightRole, "optionalRight");
+    roles.insert(OtherRightRole, "otherRight");
+    roles.insert(CategoryRole, "category");
+    roles.insert(GradeRole, "grade");
+    roles.insert(ClipboardTextRole, "clipboardText");
+
     searchTimeout = new QTimer(this);
     connect(searchTimeout, SIGNAL(timeout()), this, SLOT(stopSearch()));
 }
 
+QHash<int, QByteArray> HeinzelnisseModel::roleNames() const
+{
+    return roles;
+}
+
 QVariant HeinzelnisseModel::data(const QModelIndex &index, int role) const {
-    if(!index.isValid()) {
+    if(!index.isValid() || index.row() >= resultList.size()) {
         return QVariant();
     }
-    if(role == Qt::DisplayRole) {
-        HeinzelnisseElement* resultElement = resultList->value(index.row());
-        QMap<QString,QVariant> resultMap;
-        resultMap.insert("wordLeft", QVariant(resultElement->getWordLeft()));
-        resultMap.insert("wordRight", QVariant(resultElement->getWordRight()));
-        resultMap.insert("genderLeft", QVariant(resultElement->getGenderLeft()));
-        resultMap.insert("genderRight", QVariant(resultElement->getGenderRight()));
-        resultMap.insert("optionalLeft", QVariant(resultElement->getOptionalLeft()));
-        resultMap.insert("optionalRight", QVariant(resultElement->getOptionalRight()));
-        resultMap.insert("otherLeft", QVariant(resultElement->getOtherLeft()));
-        resultMap.insert("otherRight", QVariant(resultElement->getOtherRight()));
-        resultMap.insert("clipboardText", QVariant(resultElement->getClipboardText()));
-        return QVariant(resultMap);
+    // Delegates only request the roles they display, the values are shared with the result list
+    const HeinzelnisseElement &resultElement = resultList.at(index.row());
+    switch (role) {
+    case WordLeftRole:
+        return QVariant(resultElement.getWordLeft());
+    case GenderLeftRole:
+        return QVariant(resultElement.getGenderLeft());
+    case OptionalLeftRole:
+        return QVariant(resultElement.getOptionalLeft());
+    case OtherLeftRole:
+        return QVariant(resultElement.getOtherLeft());
+    case WordRightRole:
+        return QVariant(resultElement.getWordRight());
+    case GenderRightRole:
+        return QVariant(resultElement.getGenderRight());
+    case OptionalRightRole:
+        return QVariant(resultElement.getOptionalRight());
+    case OtherRightRole:
+        return QVariant(resultElement.getOtherRight());
+    case CategoryRole:
+        return QVariant(resultElement.getCategory());
+    case GradeRole:
+        return QVariant(resultElement.getGrade());
+    case ClipboardTextRole:
+        return QVariant(resultElement.getClipboardText());
+    default:
+        return QVariant();
     }
-    return QVariant();
 }
 
 int HeinzelnisseModel::rowCount(const QModelIndex&) const {
-    return resultList->size();
+    return resultList.size();
+}
+
+bool HeinzelnisseModel::canFetchMore(const QModelIndex &parent) const
+{
+    if (parent.isValid() || searchInProgress) {
+        return false;
+    }
+    return databaseManager->canFetchMoreResults();
+}
+
+void HeinzelnisseModel::fetchMore(const QModelIndex &parent)
+{
+    if (canFetchMore(parent)) {
+        databaseManager->fetchMoreResults();
+    }
 }
 
 void HeinzelnisseModel::search(const QString &query) {
@@ -72,11 +118,11 @@ void HeinzelnisseModel::search(const QString &query) {
 }
 
 QString HeinzelnisseModel::getResult(const int index) {
-    if (resultList->size() <= index) {
+    if (resultList.size() <= index) {
         return QString("");
     } else {
-        HeinzelnisseElement* result = resultList->value(index);
-        return QString(result->getWordLeft() + " - " + result->getWordRight());
+        const HeinzelnisseElement &result = resultList.at(index);
+        return QString(result.getWordLeft() + " - " + result.getWordRight());
     }
 }
 
@@ -96,9 +142,22 @@ QString HeinzelnisseModel::getLastQuery() {
 
 void HeinzelnisseModel::setDictionaryId(const QString &dictionaryId)
 {
+    // Entry indices of different dictionaries can't be compared, so the next results replace the whole list
+    resetPending = true;
     databaseManager->setDictionaryId(dictionaryId);
 }
 
+void HeinzelnisseModel::reloadDictionary(const QString &dictionaryId)
+{
+    resetPending = true;
+    databaseManager->reloadDictionary(dictionaryId);
+}
+
+void HeinzelnisseModel::removeDictionary(const QString &dictionaryId)
+{
+    databaseManager->removeDictionary(dictionaryId);
+}
+
 bool HeinzelnisseModel::isSearchInProgress()
 {
     return searchInProgress;
@@ -106,18 +165,98 @@ bool HeinzelnisseModel::isSearchInProgress()
 
 bool HeinzelnisseModel::isEmpty()
 {
-    if (!isSearchInProgress() && !lastQuery.isEmpty() && resultList->isEmpty()) {
+    if (!isSearchInProgress() && !lastQuery.isEmpty() && resultList.isEmpty()) {
         return true;
     }
     return false;
 }
 
+int HeinzelnisseModel::getCacheHits()
+{
+    return databaseManager->getCacheHits();
+}
+
+int HeinzelnisseModel::getCacheMisses()
+{
+    return databaseManager->getCacheMisses();
+}
+
 void HeinzelnisseModel::handleSearchCompleted(const QString &queryString)
 {
-    beginResetModel();
     lastQuery = queryString;
-    endResetModel();
+    if (resetPending) {
+        resetPending = false;
+        beginResetModel();
+        resultList = *databaseManager->getResultList();
+        endResetModel();
+    } else {
+        updateResultList(*databaseManager->getResultList());
+    }
     searchInProgress = false;
     searchTimeout->stop();
     emit searchStatusChanged();
 }
+
+void HeinzelnisseModel::updateResultList(const QVector<HeinzelnisseElement> &newResultList)
+{
+    // Rows are identified by their entry index, unchanged rows keep their delegates
+    QSet<int> newIndices;
+    for (int i = 0; i < newResultList.size(); i++) {
+        newIndices.insert(newResultList.at(i).getIndex());
+    }
+
+    // Remove obsolete rows, adjacent rows are removed together
+    int row = resultList.size() - 1;
+    while (row >= 0) {
+        if (newIndices.contains(resultList.at(row).getIndex())) {
+            row--;
+            continue;
+        }
+        int lastRow = row;
+        while (row > 0 && !newIndices.contains(resultList.at(row - 1).getIndex())) {
+            row--;
+        }
+        beginRemoveRows(QModelIndex(), row, lastRow);
+        resultList.remove(row, lastRow - row + 1);
+        endRemoveRows();
+        row--;
+    }
+
+    // The remaining rows are all part of the new results, move them into place and insert the new ones
+    QSet<int> remainingIndices;
+    for (int i = 0; i < resultList.size(); i++) {
+        remainingIndices.insert(resultList.at(i).getIndex());
+    }
+    row = 0;
+    while (row < newResultList.size()) {
+        int newIndex = newResultList.at(row).getIndex();
+        if (row < resultList.size() && resultList.at(row).getIndex() == newIndex) {
+            row++;
+            continue;
+        }
+        if (remainingIndices.contains(newIndex)) {
+            int oldRow = row + 1;
+            while (resultList.at(oldRow).getIndex() != newIndex) {
+                oldRow++;
+            }
+            beginMoveRows(QModelIndex(), oldRow, oldRow, QModelIndex(), row);
+            resultList.move(oldRow, row);
+            endMoveRows();
+            row++;
+            continue;
+        }
+        int lastRow = row;
+        while (lastRow + 1 < newResultList.size() && !remainingIndices.contains(newResultList.at(lastRow + 1).getIndex())) {
+            lastRow++;
+        }
+        beginInsertRows(QModelIndex(), row, lastRow);
+        for (int i = row; i <= lastRow; i++) {
+            resultList.insert(i, newResultList.at(i));
+        }
+        endInsertRows();
+        row = lastRow + 1;
+    }
+
+    // Both lists contain the same elements now, sharing the new one saves memory
+    resultList = newResultList;
+}
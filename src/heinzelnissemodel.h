@@ -21,9 +21,11 @@
 #define HEINZELNISSEMODEL_H
 
 #include <QAbstractListModel>
-#include <QList>
+#include <QByteArray>
+#include <QHash>
 #include <QString>
 #include <QTimer>
+#include <QVector>
 #include "databasemanager.h"
 #include "heinzelnisseelement.h"
 
@@ -31,17 +33,38 @@ class HeinzelnisseModel : public QAbstractListModel
 {
     Q_OBJECT
 public:
+    enum HeinzelnisseRoles {
+        WordLeftRole = Qt::UserRole + 1,
+        GenderLeftRole,
+        OptionalLeftRole,
+        OtherLeftRole,
+        WordRightRole,
+        GenderRightRole,
+        OptionalRightRole,
+        OtherRightRole,
+        CategoryRole,
+        GradeRole,
+        ClipboardTextRole
+    };
+
     explicit HeinzelnisseModel(QObject *parent = 0);
 
+    virtual QHash<int, QByteArray> roleNames() const;
     virtual int rowCount(const QModelIndex&) const;
     virtual QVariant data(const QModelIndex &index, int role) const;
+    virtual bool canFetchMore(const QModelIndex &parent) const;
+    virtual void fetchMore(const QModelIndex &parent);
 
     Q_INVOKABLE void search(const QString &query);
     Q_INVOKABLE QString getLastQuery();
     Q_INVOKABLE bool isSearchInProgress();
     Q_INVOKABLE bool isEmpty();
+    Q_INVOKABLE int getCacheHits();
+    Q_INVOKABLE int getCacheMisses();
 
     void setDictionaryId(const QString &dictionaryId);
+    void reloadDictionary(const QString &dictionaryId);
+    void removeDictionary(const QString &dictionaryId);
 
 public slots:
     void handleSearchCompleted(const QString &queryString);
@@ -52,11 +75,14 @@ signals:
 private:
     DatabaseManager* databaseManager;
     QTimer* searchTimeout;
-    QList<HeinzelnisseElement*>* resultList;
+    QHash<int, QByteArray> roles;
+    QVector<HeinzelnisseElement> resultList;
+    bool resetPending;
     QString lastQuery;
     bool searchInProgress;
 
     QString getResult(const int index);
+    void updateResultList(const QVector<HeinzelnisseElement> &newResultList);
 
 private slots:
     void stopSearch();
@@ -3,6 +3,9 @@ LIBS += -lz -lquazip -L../quazip/quazip
 
 QT += sql core
 
+CONFIG += link_pkgconfig
+PKGCONFIG += sqlite3
+
 DEPENDPATH += . ../quazip/quazip
 INCLUDEPATH += . ../quazip/quazip
 QMAKE_LFLAGS += -Wl,-rpath,\\$${LITERAL_DOLLAR}$${LITERAL_DOLLAR}ORIGIN/../share/harbour-wunderfitz/lib
@@ -22,9 +25,19 @@ SOURCES += harbour-wunderfitz.cpp \
     dictionarymodel.cpp \
     dictionarymetadata.cpp \
     dictccword.cpp \
+    dictionaryconnectionpool.cpp \
+    dictionaryfuzzyindex.cpp \
+    dictionaryvocabulary.cpp \
+    dictionaryinfixindex.cpp \
+    dictionarysearchcache.cpp \
     dictionarysearchworker.cpp \
     curiosity.cpp \
-    cloudapi.cpp
+    cloudapi.cpp \
+    dictccentry.cpp \
+    dictccimportqueue.cpp \
+    dictccreaderworker.cpp \
+    dictccparserworker.cpp \
+    dictionaryranking.cpp
 
 HEADERS += \
     heinzelnisseelement.h \
@@ -35,7 +48,17 @@ HEADERS += \
     dictionarymodel.h \
     dictionarymetadata.h \
     dictccword.h \
+    dictionaryconnectionpool.h \
+    dictionaryfuzzyindex.h \
+    dictionaryvocabulary.h \
+    dictionaryinfixindex.h \
+    dictionarysearchcache.h \
     dictionarysearchworker.h \
     curiosity.h \
-    cloudapi.h
+    cloudapi.h \
+    dictccentry.h \
+    dictccimportqueue.h \
+    dictccreaderworker.h \
+    dictccparserworker.h \
+    dictionaryranking.h
 